@@ -0,0 +1,79 @@
+#include "apptheme.h"
+
+#include <QApplication>
+
+namespace AppTheme {
+
+void apply(QApplication &app)
+{
+    // Селекторы по objectName вместо setStyleSheet на каждом виджете: полировка
+    // выполняется один раз при создании виджета
+    static const char *styleSheet =
+        "QMainWindow, QWidget#centralWidget { background-color: #f5f5f5; }"
+        "QStackedWidget#pages { background: white; border-radius: 8px; }"
+        "QStackedWidget#leftPanel { background: transparent; }"
+
+        "QTreeWidget#sportsTree { font-size: 16px; background: white; border: 1px solid #ddd; "
+        "border-radius: 6px; padding: 5px; }"
+        "QTreeWidget#sportsTree::item { height: 30px; padding: 5px; }"
+        "QTreeWidget#sportsTree::item:hover { background: #e6f2ff; }"
+        "QTreeWidget#sportsTree::item:selected { background: #cce0ff; color: black; }"
+
+        "QLineEdit#searchEdit { font-size: 16px; padding: 6px; border: 1px solid #ddd; "
+        "border-radius: 6px; background: white; }"
+
+        "QListView#searchResults { font-size: 14px; background: white; border: 1px solid #ddd; "
+        "border-radius: 6px; padding: 5px; }"
+        "QListView#searchResults::item { padding: 5px; border-bottom: 1px solid #eee; }"
+        "QListView#matchesList { font-size: 14px; background: white; border: 1px solid #ddd; "
+        "border-radius: 6px; }"
+        "QListView#matchesList::item { padding: 8px; border-bottom: 1px solid #eee; }"
+        "QListView::item:hover { background: #e6f2ff; }"
+        "QListView::item:selected { background: #cce0ff; color: black; }"
+
+        "QPushButton#roundButton { padding: 5px 10px; background: #4a90e2; color: white; "
+        "border-radius: 4px; }"
+        "QPushButton#backButton { font-size: 14px; padding: 8px 16px; background: #4a90e2; "
+        "color: white; border-radius: 4px; border: none; }"
+        "QPushButton#roundButton:hover, QPushButton#backButton:hover { background: #3a7bc8; }"
+
+        "QWidget#roundsPopup { background: white; border: 1px solid #ddd; border-radius: 4px; }"
+        "QPushButton#roundPageButton { padding: 5px 10px; background: white; border: 1px solid #ddd; "
+        "border-radius: 3px; }"
+        "QPushButton#roundPageButton:hover { background: #e6f2ff; }"
+        "QPushButton#roundsNavButton { padding: 2px; background: #f0f0f0; border: 1px solid #ddd; "
+        "border-radius: 3px; }"
+        "QPushButton#roundsNavButton:hover { background: #e0e0e0; }"
+        "QPushButton#roundsNavButton:disabled { color: #aaa; }"
+
+        "QLabel#matchTitle { font-size: 20px; font-weight: bold; color: #333; padding: 10px 0; }"
+        "QLabel#panelTitle { font-size: 18px; font-weight: bold; }"
+        "QLabel#sectionTitle { font-size: 16px; font-weight: bold; }"
+
+        "QTabWidget::pane { border: 1px solid #ddd; border-radius: 6px; background: white; }"
+        "QTabBar::tab { padding: 8px 16px; background: #f0f0f0; border: 1px solid #ddd; "
+        "border-bottom: none; border-top-left-radius: 4px; border-top-right-radius: 4px; }"
+        "QTabBar::tab:selected { background: white; border-bottom: 1px solid white; "
+        "margin-bottom: -1px; }"
+
+        "QTableView { font-size: 14px; background: white; border: 1px solid #ddd; "
+        "border-radius: 6px; gridline-color: #eee; }"
+        "QHeaderView::section { background-color: #4a90e2; color: white; padding: 6px; "
+        "font-weight: bold; border: none; }"
+        "QTableView::item { padding: 5px; }"
+        "QTableView::item:selected { background: #cce0ff; }"
+        "QTableView#matchStatsTable, QTableView#lineupsTable { border: none; }"
+        "QTableView#lineupsTable::item { padding: 3px; }";
+
+    app.setStyleSheet(QString::fromUtf8(styleSheet));
+}
+
+QColor accent() { return QColor(0x4a, 0x90, 0xe2); }
+QColor accentLight() { return QColor(0xcc, 0xe0, 0xff); }
+QColor border() { return QColor(0xdd, 0xdd, 0xdd); }
+QColor sectionBackground() { return QColor(0xf0, 0xf0, 0xf0); }
+QColor promotionZone() { return QColor(220, 255, 220); }
+QColor qualificationZone() { return QColor(220, 220, 255); }
+QColor relegationZone() { return QColor(255, 220, 220); }
+
+} // namespace AppTheme
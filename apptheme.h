@@ -0,0 +1,27 @@
+#ifndef APPTHEME_H
+#define APPTHEME_H
+
+#include <QColor>
+
+class QApplication;
+
+// Оформление всего приложения. Таблица стилей собирается и применяется
+// один раз при запуске; виджеты получают оформление по objectName, а
+// ячейки таблиц рисуют делегаты цветами отсюда, поэтому при загрузке
+// данных стили не пересчитываются.
+namespace AppTheme {
+
+void apply(QApplication &app);
+
+// Цвета, которыми делегаты рисуют ячейки
+QColor accent();
+QColor accentLight();
+QColor border();
+QColor sectionBackground();
+QColor promotionZone();
+QColor qualificationZone();
+QColor relegationZone();
+
+} // namespace AppTheme
+
+#endif // APPTHEME_H
@@ -0,0 +1,153 @@
+#include "syntheticdatabase.h"
+#include "sportsrepository.h"
+#include "connectionpool.h"
+#include "standingsengine.h"
+#include "teamdictionary.h"
+#include "databaseconfig.h"
+
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QDir>
+
+// Замеры путей загрузки данных приложения на синтетических БД.
+// Масштаб задаётся переменной SPORTSTRACKER_BENCH_SCALE (small, medium, large),
+// каталог для БД — SPORTSTRACKER_BENCH_DIR. Результаты в машиночитаемом виде:
+//   sportstracker-bench -o results.xml,xml
+class DataLoadingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void loadSports();
+    void loadStandings();
+    void computeStandingsFromMatches();
+    void loadRounds();
+    void loadMatchesForCurrentRound();
+    void showMatchStatsSequential();
+    void showMatchStatsParallel();
+
+private:
+    QString databasePath;
+    SportsRepository *repository = nullptr;
+    ConnectionPool *pool = nullptr;
+    int tournamentId = -1;
+    int round = -1;
+    MatchHeader header;
+};
+
+void DataLoadingBenchmark::initTestCase()
+{
+    QString scaleName = qEnvironmentVariable("SPORTSTRACKER_BENCH_SCALE", "small");
+    SyntheticDatabase::Scale scale;
+    QVERIFY2(SyntheticDatabase::scaleByName(scaleName, &scale), "Неизвестный масштаб БД");
+
+    QString directory = qEnvironmentVariable("SPORTSTRACKER_BENCH_DIR", QDir::tempPath());
+    databasePath = SyntheticDatabase::ensure(scale, directory);
+    QVERIFY2(!databasePath.isEmpty(), "Не удалось создать синтетическую БД");
+
+    // Те же параметры открытия, что и у приложения (SPORTSTRACKER_DB_*)
+    DatabaseConfig config = DatabaseConfig::fromEnvironment(databasePath);
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "benchmark");
+    QVERIFY(config.open(db, DatabaseConfig::ReadOnly));
+
+    auto dictionary = std::make_shared<TeamDictionary>();
+    QVERIFY(dictionary->load(db));
+    repository = new SportsRepository(db);
+    repository->setDictionary(dictionary);
+
+    pool = new ConnectionPool(config, 6);
+    pool->setDictionary(dictionary);
+
+    // Турнир из середины БД и матч последнего сыгранного тура
+    tournamentId = qMax(1, scale.tournaments / 2);
+    QSqlQuery query(db);
+    query.prepare("SELECT MAX(round) FROM matches WHERE tournament_id = ? AND home_goals IS NOT NULL");
+    query.addBindValue(tournamentId);
+    QVERIFY(query.exec() && query.next());
+    round = query.value(0).toInt();
+
+    QVector<MatchListRow> page = repository->matchesPage(tournamentId, round, MatchPageCursor(), 100);
+    QVERIFY(!page.isEmpty());
+    header = SportsRepository::headerFor(page.first());
+}
+
+void DataLoadingBenchmark::cleanupTestCase()
+{
+    delete pool;
+    delete repository;
+    QSqlDatabase::removeDatabase("benchmark");
+}
+
+void DataLoadingBenchmark::loadSports()
+{
+    QBENCHMARK {
+        QVector<SportRow> sports = repository->sports();
+        for (const SportRow &sport : sports) {
+            repository->tournaments(sport.id);
+        }
+    }
+}
+
+void DataLoadingBenchmark::loadStandings()
+{
+    QBENCHMARK {
+        QVERIFY(!repository->standings(tournamentId).isEmpty());
+    }
+}
+
+void DataLoadingBenchmark::computeStandingsFromMatches()
+{
+    QBENCHMARK {
+        StandingsEngine engine;
+        QVERIFY(engine.load(repository->database(), tournamentId));
+    }
+}
+
+void DataLoadingBenchmark::loadRounds()
+{
+    QBENCHMARK {
+        QVERIFY(!repository->rounds(tournamentId).isEmpty());
+    }
+}
+
+void DataLoadingBenchmark::loadMatchesForCurrentRound()
+{
+    QBENCHMARK {
+        QVERIFY(!repository->matchesPage(tournamentId, round, MatchPageCursor(), 100).isEmpty());
+    }
+}
+
+void DataLoadingBenchmark::showMatchStatsSequential()
+{
+    QBENCHMARK {
+        repository->matchStats(header);
+        repository->lineups(header);
+        repository->events(header);
+        repository->recentMatches(header.team1Id, header.date);
+        repository->recentMatches(header.team2Id, header.date);
+        repository->headToHead(header.team1Id, header.team2Id, header.date);
+    }
+}
+
+void DataLoadingBenchmark::showMatchStatsParallel()
+{
+    // Тот же путь, что у DataWorker::requestMatchDetails: шесть задач пула
+    const MatchHeader match = header;
+    QBENCHMARK {
+        pool->run([match](SportsRepository &repo) { repo.matchStats(match); });
+        pool->run([match](SportsRepository &repo) { repo.lineups(match); });
+        pool->run([match](SportsRepository &repo) { repo.events(match); });
+        pool->run([match](SportsRepository &repo) { repo.recentMatches(match.team1Id, match.date); });
+        pool->run([match](SportsRepository &repo) { repo.recentMatches(match.team2Id, match.date); });
+        pool->run([match](SportsRepository &repo) { repo.headToHead(match.team1Id, match.team2Id, match.date); });
+        pool->waitForDone();
+    }
+}
+
+QTEST_GUILESS_MAIN(DataLoadingBenchmark)
+
+#include "benchmark_dataloading.moc"
@@ -0,0 +1,287 @@
+#include "syntheticdatabase.h"
+#include "schemamigrator.h"
+#include "standingsengine.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDir>
+#include <QVariant>
+#include <QDebug>
+#include <algorithm>
+#include <random>
+
+namespace {
+
+// Меняется при любом изменении содержимого, чтобы не использовать старые файлы
+const int GeneratorVersion = 1;
+
+const int TeamsPerTournament = 20;
+const int PlayersPerTeam = 25;
+const int RoundsPerTournament = (TeamsPerTournament - 1) * 2;
+const int UnplayedRounds = 5;
+const int CommitEvery = 200000;
+
+const char *const SchemaStatements[] = {
+    "CREATE TABLE sports (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT NOT NULL UNIQUE)",
+    "CREATE TABLE tournaments (id INTEGER PRIMARY KEY AUTOINCREMENT, sport_id INTEGER NOT NULL, "
+    "name TEXT NOT NULL, season TEXT, start_date TEXT, end_date TEXT, logo_url TEXT, "
+    "FOREIGN KEY (sport_id) REFERENCES sports(id), UNIQUE(sport_id, name, season))",
+    "CREATE TABLE tournament_stages (id INTEGER PRIMARY KEY AUTOINCREMENT, tournament_id INTEGER NOT NULL, "
+    "name TEXT NOT NULL, stage_order INTEGER NOT NULL, is_knockout BOOLEAN DEFAULT 0, "
+    "FOREIGN KEY (tournament_id) REFERENCES tournaments(id), UNIQUE(tournament_id, name))",
+    "CREATE TABLE teams (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT NOT NULL UNIQUE, short_name TEXT, "
+    "country TEXT, founded_year INTEGER, logo_url TEXT, home_stadium TEXT)",
+    "CREATE TABLE players (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT NOT NULL, nationality TEXT, "
+    "position TEXT, photo_url TEXT, team_id INTEGER NOT NULL DEFAULT 0, jersey_number INTEGER)",
+    "CREATE TABLE matches (id INTEGER PRIMARY KEY AUTOINCREMENT, tournament_id INTEGER NOT NULL, "
+    "stage_id INTEGER, date TEXT NOT NULL, team1_id INTEGER NOT NULL, team2_id INTEGER NOT NULL, "
+    "score TEXT, venue TEXT, attendance INTEGER, referee TEXT, match_status TEXT, details TEXT, "
+    "round INTEGER NOT NULL DEFAULT 1)",
+    "CREATE TABLE match_stats (id INTEGER PRIMARY KEY AUTOINCREMENT, match_id INTEGER NOT NULL, "
+    "team_id INTEGER NOT NULL, stat_name TEXT NOT NULL, stat_value TEXT NOT NULL, "
+    "UNIQUE(match_id, team_id, stat_name))",
+    "CREATE TABLE match_lineups (id INTEGER PRIMARY KEY AUTOINCREMENT, match_id INTEGER NOT NULL, "
+    "team_id INTEGER NOT NULL, player_id INTEGER NOT NULL, position TEXT NOT NULL, "
+    "is_starting BOOLEAN DEFAULT 1, jersey_number INTEGER, UNIQUE(match_id, team_id, player_id))",
+    "CREATE TABLE match_events (id INTEGER PRIMARY KEY AUTOINCREMENT, match_id INTEGER NOT NULL, "
+    "event_type TEXT NOT NULL, minute INTEGER NOT NULL, team_id INTEGER NOT NULL, player_id INTEGER, "
+    "related_player_id INTEGER, description TEXT)",
+    "CREATE TABLE standings (id INTEGER PRIMARY KEY AUTOINCREMENT, tournament_id INTEGER NOT NULL, "
+    "team_id INTEGER NOT NULL, position INTEGER NOT NULL, points INTEGER DEFAULT 0, "
+    "games_played INTEGER DEFAULT 0, wins INTEGER DEFAULT 0, draws INTEGER DEFAULT 0, "
+    "losses INTEGER DEFAULT 0, goals_for INTEGER DEFAULT 0, goals_against INTEGER DEFAULT 0, "
+    "goal_difference INTEGER DEFAULT 0, UNIQUE(tournament_id, team_id))",
+};
+
+// Индексы исходной БД; остальные создают миграции приложения
+const char *const IndexStatements[] = {
+    "CREATE INDEX idx_matches_tournament ON matches(tournament_id)",
+    "CREATE INDEX idx_matches_date ON matches(date)",
+    "CREATE INDEX idx_matches_teams ON matches(team1_id, team2_id)",
+    "CREATE INDEX idx_match_events_match ON match_events(match_id)",
+    "CREATE INDEX idx_match_events_player ON match_events(player_id)",
+    "CREATE INDEX idx_standings_tournament ON standings(tournament_id)",
+};
+
+const char *const StatNames[] = {
+    "Владение мячом", "Удары", "Удары в створ", "Угловые", "Фолы",
+    "Офсайды", "Желтые карточки", "Красные карточки", "Сэйвы вратаря"
+};
+
+const char *const Positions[] = {"GK", "RB", "CB", "CB", "LB", "CM", "CM", "RW", "CF", "LW", "MF"};
+
+// Распределения стандартной библиотеки различаются между реализациями,
+// поэтому числа берутся прямо из mt19937, выход которого стандартизирован
+class Random
+{
+public:
+    explicit Random(quint32 seed) : engine(seed) {}
+    int below(int n) { return int(engine() % quint32(n)); }
+
+private:
+    std::mt19937 engine;
+};
+
+class Inserter
+{
+public:
+    Inserter(QSqlDatabase db, const QString &sql) : db(db), query(db) { query.prepare(sql); }
+
+    bool insert(const QVariantList &values)
+    {
+        for (int i = 0; i < values.size(); ++i) {
+            query.bindValue(i, values[i]);
+        }
+        if (!query.exec()) {
+            qDebug() << "Ошибка генерации:" << query.lastError().text();
+            return false;
+        }
+        // Крупные транзакции без ожидания диска
+        if (++pending >= CommitEvery) {
+            pending = 0;
+            return db.commit() && db.transaction();
+        }
+        return true;
+    }
+
+private:
+    QSqlDatabase db;
+    QSqlQuery query;
+    int pending = 0;
+};
+
+} // namespace
+
+bool SyntheticDatabase::scaleByName(const QString &name, Scale *scale)
+{
+    static const Scale scales[] = {
+        {"small", 10, 50},
+        {"medium", 100, 50},
+        {"large", 2632, 50},
+    };
+    for (const Scale &candidate : scales) {
+        if (name == candidate.name) {
+            *scale = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+QString SyntheticDatabase::ensure(const Scale &scale, const QString &directory)
+{
+    QDir().mkpath(directory);
+    QString path = QDir(directory).filePath(
+        QString("sportstracker-bench-%1-v%2.db").arg(scale.name).arg(GeneratorVersion));
+    if (QFile::exists(path)) return path;
+
+    // Сначала пишем во временный файл, чтобы прерванная генерация не оставила неполную БД
+    QString partial = path + ".partial";
+    QFile::remove(partial);
+    QElapsedTimer timer;
+    timer.start();
+    if (!generate(scale, partial) || !QFile::rename(partial, path)) {
+        QFile::remove(partial);
+        return QString();
+    }
+    qDebug() << "Синтетическая БД" << scale.name << "создана за" << timer.elapsed() / 1000 << "с";
+    return path;
+}
+
+bool SyntheticDatabase::generate(const Scale &scale, const QString &path)
+{
+    const QString connectionName = QString("synthetic-%1").arg(scale.name);
+    bool ok = true;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            qDebug() << "Не удалось создать БД:" << db.lastError().text();
+            ok = false;
+        }
+
+        QSqlQuery query(db);
+        if (ok) {
+            ok = query.exec("PRAGMA journal_mode = OFF") && query.exec("PRAGMA synchronous = OFF");
+            for (const char *statement : SchemaStatements) {
+                ok = ok && query.exec(statement);
+            }
+            ok = ok && db.transaction();
+        }
+
+        Random random(20240101u + quint32(scale.tournaments));
+        Inserter sports(db, "INSERT INTO sports (id, name) VALUES (?, ?)");
+        Inserter tournaments(db, "INSERT INTO tournaments (id, sport_id, name, season) VALUES (?, ?, ?, ?)");
+        Inserter teams(db, "INSERT INTO teams (id, name) VALUES (?, ?)");
+        Inserter players(db, "INSERT INTO players (id, name, position, team_id, jersey_number) "
+                             "VALUES (?, ?, ?, ?, ?)");
+        Inserter matches(db, "INSERT INTO matches (id, tournament_id, date, team1_id, team2_id, score, "
+                             "match_status, round) VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+        Inserter stats(db, "INSERT INTO match_stats (match_id, team_id, stat_name, stat_value) "
+                           "VALUES (?, ?, ?, ?)");
+        Inserter lineups(db, "INSERT INTO match_lineups (match_id, team_id, player_id, position, "
+                             "is_starting, jersey_number) VALUES (?, ?, ?, ?, ?, ?)");
+        Inserter events(db, "INSERT INTO match_events (match_id, event_type, minute, team_id, player_id, "
+                            "description) VALUES (?, ?, ?, ?, ?, ?)");
+
+        ok = ok && sports.insert({21, "Футбол"});
+
+        const QDateTime seasonStart(QDate(2023, 8, 12), QTime(15, 0));
+        int matchId = 0;
+
+        for (int t = 1; ok && t <= scale.tournaments; ++t) {
+            ok = tournaments.insert({t, 21, QString("Лига %1").arg(t), "2023/2024"});
+
+            const int firstTeam = (t - 1) * TeamsPerTournament + 1;
+            for (int i = 0; ok && i < TeamsPerTournament; ++i) {
+                int teamId = firstTeam + i;
+                ok = teams.insert({teamId, QString("Команда %1").arg(teamId)});
+                for (int p = 0; ok && p < PlayersPerTeam; ++p) {
+                    int playerId = (teamId - 1) * PlayersPerTeam + p + 1;
+                    ok = players.insert({playerId, QString("Игрок %1").arg(playerId),
+                                         Positions[p % 11], teamId, p + 1});
+                }
+            }
+
+            // Круговая система: команда 0 на месте, остальные поворачиваются
+            QVector<int> circle;
+            for (int i = 0; i < TeamsPerTournament; ++i) circle.append(firstTeam + i);
+
+            for (int round = 1; ok && round <= RoundsPerTournament; ++round) {
+                const bool secondHalf = round > RoundsPerTournament / 2;
+                const bool played = round <= RoundsPerTournament - UnplayedRounds;
+                const QDateTime roundDate = seasonStart.addDays(7 * (round - 1));
+
+                for (int pair = 0; ok && pair < TeamsPerTournament / 2; ++pair) {
+                    int home = circle[pair];
+                    int away = circle[TeamsPerTournament - 1 - pair];
+                    if (secondHalf) std::swap(home, away);
+
+                    ++matchId;
+                    int homeGoals = random.below(4);
+                    int awayGoals = random.below(3);
+                    QString date = roundDate.addSecs(3600 * (pair % 5)).toString("yyyy-MM-dd HH:mm:ss");
+                    ok = matches.insert({matchId, t, date, home, away,
+                                         played ? QVariant(QString("%1-%2").arg(homeGoals).arg(awayGoals)) : QVariant(),
+                                         played ? "finished" : "scheduled", round});
+                    if (!played) continue;
+
+                    for (int side = 0; ok && side < 2; ++side) {
+                        int teamId = side == 0 ? home : away;
+                        int firstPlayer = (teamId - 1) * PlayersPerTeam + 1;
+                        for (int s = 0; ok && s < 9; ++s) {
+                            QString value = s == 0 ? QString("%1%").arg(side == 0 ? 40 + random.below(21) : 50)
+                                                   : QString::number(random.below(15));
+                            ok = stats.insert({matchId, teamId, StatNames[s], value});
+                        }
+                        for (int p = 0; ok && p < 14; ++p) {
+                            ok = lineups.insert({matchId, teamId, firstPlayer + p, Positions[p % 11],
+                                                 p < 11 ? 1 : 0, p + 1});
+                        }
+                    }
+
+                    // Голы по счёту, остальное — карточки и замены
+                    int generated = 0;
+                    for (int side = 0; ok && side < 2; ++side) {
+                        int teamId = side == 0 ? home : away;
+                        int goals = side == 0 ? homeGoals : awayGoals;
+                        for (int g = 0; ok && g < goals; ++g, ++generated) {
+                            int player = (teamId - 1) * PlayersPerTeam + 1 + 7 + random.below(4);
+                            ok = events.insert({matchId, "goal", 1 + random.below(90), teamId, player, "Гол"});
+                        }
+                    }
+                    for (; ok && generated < scale.eventsPerMatch; ++generated) {
+                        int teamId = random.below(2) == 0 ? home : away;
+                        int player = (teamId - 1) * PlayersPerTeam + 1 + random.below(14);
+                        int kind = random.below(10);
+                        const char *type = kind < 6 ? "substitution" : (kind < 9 ? "yellow_card" : "red_card");
+                        ok = events.insert({matchId, type, 1 + random.below(90), teamId, player, QVariant()});
+                    }
+                }
+
+                std::rotate(circle.begin() + 1, circle.end() - 1, circle.end());
+            }
+        }
+
+        ok = ok && db.commit();
+        for (const char *statement : IndexStatements) {
+            ok = ok && query.exec(statement);
+        }
+
+        // Индексы и производные столбцы приложения строятся один раз после данных
+        ok = ok && SchemaMigrator::migrate(db);
+
+        // Сохранённые таблицы, как после первого открытия турниров в приложении
+        for (int t = 1; ok && t <= scale.tournaments; ++t) {
+            StandingsEngine engine;
+            ok = engine.load(db, t) && engine.save(db);
+        }
+
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return ok;
+}
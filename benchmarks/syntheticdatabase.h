@@ -0,0 +1,31 @@
+#ifndef SYNTHETICDATABASE_H
+#define SYNTHETICDATABASE_H
+
+#include <QString>
+
+// Генератор синтетических БД SportsTracker для замеров. Содержимое зависит
+// только от масштаба: генератор случайных чисел инициализируется константой,
+// поэтому при одинаковом масштабе получаются одинаковые БД на любой машине.
+// Каждый турнир — двухкруговая лига из 20 команд (38 туров, 380 матчей);
+// последние туры ещё не сыграны.
+class SyntheticDatabase
+{
+public:
+    struct Scale
+    {
+        const char *name;
+        int tournaments;
+        int eventsPerMatch;
+    };
+
+    // small: ~3.8 тыс. матчей; medium: ~38 тыс.; large: ~1 млн матчей и ~50 млн событий
+    static bool scaleByName(const QString &name, Scale *scale);
+
+    // Путь к готовой БД масштаба; БД создаётся, если её ещё нет
+    static QString ensure(const Scale &scale, const QString &directory);
+
+private:
+    static bool generate(const Scale &scale, const QString &path);
+};
+
+#endif // SYNTHETICDATABASE_H
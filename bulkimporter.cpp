@@ -0,0 +1,470 @@
+#include "bulkimporter.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonParseError>
+#include <QVariant>
+#include <QDebug>
+#include <memory>
+
+namespace {
+
+// Сколько ошибок вставки выводить по каждому файлу; остальные только считаются
+const quint64 MaxReportedErrors = 10;
+
+QVariant jsonToVariant(const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        return QVariant();
+    case QJsonValue::Bool:
+        return value.toBool() ? 1 : 0;
+    case QJsonValue::Double: {
+        double number = value.toDouble();
+        qint64 integer = qint64(number);
+        if (double(integer) == number) return integer;
+        return number;
+    }
+    case QJsonValue::String:
+        return value.toString();
+    default:
+        // Вложенные объекты и массивы сохраняются текстом JSON
+        QJsonDocument document = value.isArray() ? QJsonDocument(value.toArray())
+                                                 : QJsonDocument(value.toObject());
+        return QString::fromUtf8(document.toJson(QJsonDocument::Compact));
+    }
+}
+
+} // namespace
+
+// Источник строк для вставки: заголовок со списком столбцов и значения по порядку
+class BulkImporter::RowReader
+{
+public:
+    virtual ~RowReader() {}
+
+    virtual bool open(const QString &path) = 0;
+    virtual bool next(QVariantList *values) = 0;
+
+    QStringList columns() const { return header; }
+    QString errorString() const { return error; }
+    bool failed() const { return !error.isEmpty(); }
+
+protected:
+    QStringList header;
+    QString error;
+};
+
+// CSV с заголовком. Разделитель — запятая или точка с запятой (по заголовку).
+// Пустое поле без кавычек записывается как NULL, "" — как пустая строка.
+class BulkImporter::CsvReader : public BulkImporter::RowReader
+{
+public:
+    bool open(const QString &path) override
+    {
+        file.setFileName(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            error = file.errorString();
+            return false;
+        }
+
+        QByteArray firstLine = file.readLine();
+        if (firstLine.startsWith("\xEF\xBB\xBF")) {
+            firstLine.remove(0, 3);
+        }
+        delimiter = (firstLine.contains(';') && !firstLine.contains(',')) ? ';' : ',';
+
+        QVariantList fields;
+        if (!parseRecord(QString::fromUtf8(firstLine), &fields)) {
+            error = "Не удалось прочитать заголовок";
+            return false;
+        }
+        for (const QVariant &field : fields) {
+            header.append(field.toString().trimmed());
+        }
+        return !header.isEmpty();
+    }
+
+    bool next(QVariantList *values) override
+    {
+        while (!file.atEnd()) {
+            QString line = QString::fromUtf8(file.readLine());
+            if (line.trimmed().isEmpty()) continue;
+            return parseRecord(line, values);
+        }
+        return false;
+    }
+
+private:
+    bool parseRecord(QString line, QVariantList *fields)
+    {
+        fields->clear();
+        QString field;
+        bool quoted = false;
+        bool inQuotes = false;
+
+        for (int i = 0; ; ++i) {
+            if (i >= line.size()) {
+                // Перевод строки внутри кавычек: запись продолжается на следующей строке
+                if (inQuotes && !file.atEnd()) {
+                    line += QString::fromUtf8(file.readLine());
+                    if (i >= line.size()) break;
+                } else {
+                    break;
+                }
+            }
+
+            QChar c = line.at(i);
+            if (inQuotes) {
+                if (c == '"') {
+                    if (i + 1 < line.size() && line.at(i + 1) == '"') {
+                        field += '"';
+                        ++i;
+                    } else {
+                        inQuotes = false;
+                    }
+                } else {
+                    field += c;
+                }
+            } else if (c == '"') {
+                inQuotes = true;
+                quoted = true;
+            } else if (c == delimiter) {
+                appendField(fields, field, quoted);
+                field.clear();
+                quoted = false;
+            } else if (c != '\r' && c != '\n') {
+                field += c;
+            }
+        }
+
+        if (inQuotes) {
+            error = "Незакрытые кавычки в конце файла";
+            return false;
+        }
+        appendField(fields, field, quoted);
+        return true;
+    }
+
+    static void appendField(QVariantList *fields, const QString &field, bool quoted)
+    {
+        if (field.isEmpty() && !quoted) {
+            fields->append(QVariant());
+        } else {
+            fields->append(field);
+        }
+    }
+
+    QFile file;
+    QChar delimiter;
+};
+
+// NDJSON: по объекту на строку, файл читается построчно. Файл .json с массивом
+// объектов тоже принимается, но разбирается целиком.
+class BulkImporter::JsonLinesReader : public BulkImporter::RowReader
+{
+public:
+    bool open(const QString &path) override
+    {
+        file.setFileName(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            error = file.errorString();
+            return false;
+        }
+
+        char first = 0;
+        while (file.peek(&first, 1) == 1 && QChar(first).isSpace()) {
+            file.read(&first, 1);
+        }
+
+        if (first == '[') {
+            QJsonParseError parseError;
+            QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+            if (!document.isArray()) {
+                error = parseError.errorString();
+                return false;
+            }
+            array = document.array();
+            arrayMode = true;
+            if (!array.isEmpty()) {
+                header = array.first().toObject().keys();
+            }
+            return true;
+        }
+
+        // Столбцы задаёт первый объект; остальные объекты читаются по тем же ключам
+        if (!readObject(&pending)) {
+            if (error.isEmpty()) error = "Файл не содержит объектов";
+            return false;
+        }
+        header = pending.keys();
+        hasPending = true;
+        return true;
+    }
+
+    bool next(QVariantList *values) override
+    {
+        QJsonObject object;
+        if (arrayMode) {
+            if (arrayIndex >= array.size()) return false;
+            object = array.at(arrayIndex++).toObject();
+        } else if (hasPending) {
+            object = pending;
+            hasPending = false;
+        } else if (!readObject(&object)) {
+            return false;
+        }
+
+        values->clear();
+        for (const QString &column : header) {
+            values->append(jsonToVariant(object.value(column)));
+        }
+        return true;
+    }
+
+private:
+    bool readObject(QJsonObject *object)
+    {
+        while (!file.atEnd()) {
+            QByteArray line = file.readLine().trimmed();
+            if (line.isEmpty()) continue;
+
+            QJsonParseError parseError;
+            QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+            if (!document.isObject()) {
+                error = QString("Строка не является объектом JSON: %1").arg(parseError.errorString());
+                return false;
+            }
+            *object = document.object();
+            return true;
+        }
+        return false;
+    }
+
+    QFile file;
+    QJsonObject pending;
+    bool hasPending = false;
+    QJsonArray array;
+    int arrayIndex = 0;
+    bool arrayMode = false;
+};
+
+BulkImporter::BulkImporter(const QSqlDatabase &db)
+    : db(db),
+      batchSize(100000),
+      deferIndexes(true),
+      inTransaction(false),
+      rowsInBatch(0)
+{
+}
+
+QStringList BulkImporter::importableTables()
+{
+    // В порядке загрузки: сначала справочники, затем матчи и их подробности
+    return {"teams", "players", "matches", "match_lineups", "match_events", "match_stats"};
+}
+
+QStringList BulkImporter::tableColumns(const QString &table)
+{
+    auto it = columnsByTable.constFind(table);
+    if (it != columnsByTable.constEnd()) return it.value();
+
+    QStringList columns;
+    QSqlRecord record = db.record(table);
+    for (int i = 0; i < record.count(); ++i) {
+        columns.append(record.fieldName(i));
+    }
+    columnsByTable.insert(table, columns);
+    return columns;
+}
+
+bool BulkImporter::begin(const QStringList &tables)
+{
+    QSqlQuery query(db);
+
+    // На время загрузки SQLite не ждёт сброса каждой транзакции на диск
+    // и держит больше страниц в памяти; настройки действуют до закрытия соединения
+    const QStringList pragmas = {
+        "PRAGMA synchronous = OFF",
+        "PRAGMA temp_store = MEMORY",
+        "PRAGMA cache_size = -262144"
+    };
+    for (const QString &pragma : pragmas) {
+        if (!query.exec(pragma)) {
+            qDebug() << "Ошибка настройки соединения:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    if (deferIndexes) {
+        // Индексы, созданные ограничениями UNIQUE, удалить нельзя (sql у них NULL)
+        QSqlQuery indexQuery(db);
+        indexQuery.prepare("SELECT name, sql FROM sqlite_master "
+                           "WHERE type = 'index' AND tbl_name = ? AND sql IS NOT NULL");
+        for (const QString &table : tables) {
+            indexQuery.addBindValue(table);
+            if (!indexQuery.exec()) {
+                qDebug() << "Ошибка чтения индексов:" << indexQuery.lastError().text();
+                return false;
+            }
+
+            QStringList names;
+            while (indexQuery.next()) {
+                names.append(indexQuery.value(0).toString());
+                droppedIndexes.append(indexQuery.value(1).toString());
+            }
+            indexQuery.finish();
+
+            for (const QString &name : names) {
+                if (!query.exec(QString("DROP INDEX IF EXISTS \"%1\"").arg(name))) {
+                    qDebug() << "Не удалось удалить индекс" << name << ":" << query.lastError().text();
+                    return false;
+                }
+            }
+        }
+    }
+
+    inTransaction = db.transaction();
+    rowsInBatch = 0;
+    if (!inTransaction) {
+        qDebug() << "Не удалось начать транзакцию:" << db.lastError().text();
+    }
+    return inTransaction;
+}
+
+bool BulkImporter::commitBatch()
+{
+    if (inTransaction && !db.commit()) {
+        qDebug() << "Не удалось зафиксировать пакет:" << db.lastError().text();
+        db.rollback();
+        inTransaction = false;
+        return false;
+    }
+
+    rowsInBatch = 0;
+    inTransaction = db.transaction();
+    return inTransaction;
+}
+
+bool BulkImporter::importFile(const QString &table, const QString &path, Report *report)
+{
+    report->table = table;
+    report->path = path;
+
+    if (!importableTables().contains(table)) {
+        qDebug() << "Таблица" << table << "не поддерживается загрузкой";
+        return false;
+    }
+
+    QString suffix = QFileInfo(path).suffix().toLower();
+    std::unique_ptr<RowReader> reader;
+    if (suffix == "csv") {
+        reader.reset(new CsvReader);
+    } else if (suffix == "ndjson" || suffix == "jsonl" || suffix == "json") {
+        reader.reset(new JsonLinesReader);
+    } else {
+        qDebug() << "Неизвестный формат файла:" << path;
+        return false;
+    }
+
+    if (!reader->open(path)) {
+        qDebug() << "Не удалось открыть" << path << ":" << reader->errorString();
+        return false;
+    }
+    return importRows(table, *reader, report);
+}
+
+bool BulkImporter::importRows(const QString &table, RowReader &reader, Report *report)
+{
+    const QStringList columns = reader.columns();
+    const QStringList known = tableColumns(table);
+
+    QStringList quoted;
+    QStringList placeholders;
+    for (const QString &column : columns) {
+        if (!known.contains(column)) {
+            qDebug() << "Столбец" << column << "отсутствует в таблице" << table;
+            return false;
+        }
+        quoted.append(QString("\"%1\"").arg(column));
+        placeholders.append("?");
+    }
+
+    QSqlQuery insert(db);
+    if (!insert.prepare(QString("INSERT INTO %1 (%2) VALUES (%3)")
+                            .arg(table, quoted.join(", "), placeholders.join(", ")))) {
+        qDebug() << "Ошибка подготовки вставки:" << insert.lastError().text();
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVariantList values;
+    while (reader.next(&values)) {
+        if (values.size() > columns.size()) {
+            report->rejected++;
+            continue;
+        }
+
+        for (int i = 0; i < columns.size(); ++i) {
+            insert.bindValue(i, values.value(i));
+        }
+
+        // Ошибка одной строки откатывает только её, транзакция пакета продолжается
+        if (insert.exec()) {
+            report->rows++;
+        } else if (++report->rejected <= MaxReportedErrors) {
+            qDebug() << "Строка отклонена:" << insert.lastError().text();
+        }
+
+        if (++rowsInBatch >= batchSize && !commitBatch()) {
+            return false;
+        }
+    }
+
+    bool ok = !reader.failed() && commitBatch();
+    report->elapsedMs = timer.elapsed();
+    if (reader.failed()) {
+        qDebug() << "Ошибка чтения" << report->path << ":" << reader.errorString();
+    }
+    return ok;
+}
+
+bool BulkImporter::finish()
+{
+    bool ok = true;
+    if (inTransaction && !db.commit()) {
+        qDebug() << "Не удалось зафиксировать загрузку:" << db.lastError().text();
+        db.rollback();
+        ok = false;
+    }
+    inTransaction = false;
+
+    // Индексы строятся заново даже после ошибки загрузки, чтобы схема не осталась без них
+    QSqlQuery query(db);
+    db.transaction();
+    for (const QString &sql : droppedIndexes) {
+        if (!query.exec(sql)) {
+            qDebug() << "Не удалось восстановить индекс:" << query.lastError().text() << sql;
+            ok = false;
+        }
+    }
+    if (!db.commit()) {
+        qDebug() << "Не удалось зафиксировать индексы:" << db.lastError().text();
+        ok = false;
+    }
+    droppedIndexes.clear();
+
+    if (!query.exec("ANALYZE")) {
+        qDebug() << "Ошибка ANALYZE:" << query.lastError().text();
+    }
+    return ok;
+}
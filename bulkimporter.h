@@ -0,0 +1,57 @@
+#ifndef BULKIMPORTER_H
+#define BULKIMPORTER_H
+
+#include <QSqlDatabase>
+#include <QStringList>
+#include <QHash>
+
+// Потоковая загрузка данных сезона (матчи, составы, события, статистика)
+// из CSV или NDJSON в sports.db. Первая строка CSV (или ключи первого
+// объекта NDJSON) задаёт столбцы таблицы; допустимы только существующие
+// столбцы. Строки вставляются одним подготовленным запросом крупными
+// транзакциями, а вторичные индексы таблиц удаляются в begin() и
+// строятся заново в finish() один раз на весь объём.
+class BulkImporter
+{
+public:
+    struct Report
+    {
+        QString table;
+        QString path;
+        quint64 rows = 0;
+        quint64 rejected = 0;
+        qint64 elapsedMs = 0;
+
+        double rowsPerSecond() const { return elapsedMs > 0 ? rows * 1000.0 / elapsedMs : rows; }
+    };
+
+    explicit BulkImporter(const QSqlDatabase &db);
+
+    void setBatchSize(int rows) { batchSize = qMax(1, rows); }
+    void setDeferIndexes(bool defer) { deferIndexes = defer; }
+
+    static QStringList importableTables();
+
+    bool begin(const QStringList &tables);
+    bool importFile(const QString &table, const QString &path, Report *report);
+    bool finish();
+
+private:
+    class RowReader;
+    class CsvReader;
+    class JsonLinesReader;
+
+    bool importRows(const QString &table, RowReader &reader, Report *report);
+    bool commitBatch();
+    QStringList tableColumns(const QString &table);
+
+    QSqlDatabase db;
+    int batchSize;
+    bool deferIndexes;
+    bool inTransaction;
+    int rowsInBatch;
+    QStringList droppedIndexes;        // CREATE INDEX для восстановления в finish()
+    QHash<QString, QStringList> columnsByTable;
+};
+
+#endif // BULKIMPORTER_H
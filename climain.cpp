@@ -0,0 +1,97 @@
+#include "reportgenerator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QThread>
+#include <QDir>
+#include <QDebug>
+
+// Пакетная генерация отчётов без дисплея:
+//   sportstracker-cli --all --standings --matches --format html --out reports
+//   sportstracker-cli --h2h 12:15 --h2h 3:7 --format json
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("sportstracker-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Отчёты SportsTracker в CSV, JSON или HTML");
+    parser.addHelpOption();
+
+    QCommandLineOption dbOption("db", "Путь к файлу БД.", "path",
+                                QDir::homePath() + "/database/sports.db");
+    QCommandLineOption jobsOption("jobs", "Число параллельных задач (по умолчанию — по числу ядер).",
+                                  "n", QString::number(QThread::idealThreadCount()));
+    QCommandLineOption formatOption("format", "Формат: csv, json или html.", "format", "csv");
+    QCommandLineOption outOption("out", "Каталог для отчётов.", "dir", "reports");
+    QCommandLineOption tournamentOption("tournament", "id турнира (можно несколько раз).", "id");
+    QCommandLineOption allOption("all", "Все турниры БД.");
+    QCommandLineOption standingsOption("standings", "Турнирные таблицы выбранных турниров.");
+    QCommandLineOption matchesOption("matches", "Списки матчей выбранных турниров.");
+    QCommandLineOption h2hOption("h2h", "Очные встречи пары команд team1:team2.", "pair");
+    parser.addOptions({dbOption, jobsOption, formatOption, outOption, tournamentOption,
+                       allOption, standingsOption, matchesOption, h2hOption});
+    parser.process(app);
+
+    ReportGenerator::Format format;
+    if (!ReportGenerator::parseFormat(parser.value(formatOption), &format)) {
+        qDebug() << "Неизвестный формат:" << parser.value(formatOption);
+        return 1;
+    }
+
+    ReportGenerator generator(parser.value(dbOption), parser.value(jobsOption).toInt());
+    if (!generator.open()) {
+        return 1;
+    }
+    generator.setOutput(parser.value(outOption), format);
+
+    QList<int> tournaments;
+    if (parser.isSet(allOption)) {
+        tournaments = generator.tournamentIds();
+    }
+    for (const QString &id : parser.values(tournamentOption)) {
+        tournaments.append(id.toInt());
+    }
+
+    // Без явного выбора отчётов для турниров строится таблица
+    bool standings = parser.isSet(standingsOption) || !parser.isSet(matchesOption);
+    int reports = 0;
+    for (int tournamentId : tournaments) {
+        if (standings) {
+            generator.addStandings(tournamentId);
+            reports++;
+        }
+        if (parser.isSet(matchesOption)) {
+            generator.addMatches(tournamentId);
+            reports++;
+        }
+    }
+
+    for (const QString &pair : parser.values(h2hOption)) {
+        const QStringList ids = pair.split(':');
+        if (ids.size() != 2) {
+            qDebug() << "Пара команд задаётся как team1:team2, получено" << pair;
+            return 1;
+        }
+        generator.addHeadToHead(ids[0].toInt(), ids[1].toInt());
+        reports++;
+    }
+
+    if (reports == 0) {
+        parser.showHelp(1);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int failed = generator.run();
+
+    QTextStream out(stdout);
+    out << QString("Отчётов: %1, ошибок: %2, время: %3 с")
+               .arg(reports)
+               .arg(failed)
+               .arg(timer.elapsed() / 1000.0, 0, 'f', 2)
+        << Qt::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include "connectionpool.h"
+#include "sportsrepository.h"
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QThread>
+#include <QDebug>
+
+struct ConnectionPool::PooledConnection
+{
+    QString connectionName;
+    SportsRepository *repository = nullptr;
+
+    ~PooledConnection()
+    {
+        if (repository) {
+            repository->logStatementStats(connectionName);
+        }
+        delete repository;
+        {
+            QSqlDatabase poolDb = QSqlDatabase::database(connectionName, false);
+            if (poolDb.isOpen()) {
+                poolDb.close();
+            }
+        }
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+};
+
+ConnectionPool::ConnectionPool(const DatabaseConfig &config, int maxConnections)
+    : config(config)
+{
+    threadPool.setMaxThreadCount(maxConnections);
+    // Потоки не завершаются по простою, чтобы не переоткрывать соединения
+    threadPool.setExpiryTimeout(-1);
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    threadPool.waitForDone();
+}
+
+void ConnectionPool::waitForDone()
+{
+    threadPool.waitForDone();
+}
+
+void ConnectionPool::setDictionary(const std::shared_ptr<const TeamDictionary> &newDictionary)
+{
+    QMutexLocker locker(&dictionaryMutex);
+    dictionary = newDictionary;
+}
+
+void ConnectionPool::run(std::function<void(SportsRepository &)> task)
+{
+    threadPool.start([this, task]() {
+        SportsRepository *repository = repositoryForCurrentThread();
+        if (repository) {
+            {
+                QMutexLocker locker(&dictionaryMutex);
+                repository->setDictionary(dictionary);
+            }
+            task(*repository);
+        }
+    });
+}
+
+SportsRepository *ConnectionPool::repositoryForCurrentThread()
+{
+    if (connections.hasLocalData()) {
+        return connections.localData()->repository;
+    }
+
+    PooledConnection *connection = new PooledConnection;
+    connection->connectionName = QString("pool-%1-%2")
+        .arg(reinterpret_cast<quintptr>(this))
+        .arg(reinterpret_cast<quintptr>(QThread::currentThread()));
+
+    QSqlDatabase poolDb = QSqlDatabase::addDatabase("QSQLITE", connection->connectionName);
+    if (config.open(poolDb, DatabaseConfig::ReadOnly)) {
+        connection->repository = new SportsRepository(poolDb);
+    } else {
+        qDebug() << "Пул не смог открыть БД:" << poolDb.lastError().text();
+    }
+
+    // Сохраняем даже неудачное соединение, чтобы не пытаться открыть его на каждой задаче
+    connections.setLocalData(connection);
+    return connection->repository;
+}
@@ -0,0 +1,43 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include "databaseconfig.h"
+
+#include <QString>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <QMutex>
+#include <functional>
+#include <memory>
+
+class SportsRepository;
+class TeamDictionary;
+
+// Небольшой пул потоков, у каждого из которых своё соединение SQLite
+// только для чтения. Соединение открывается при первой задаче потока
+// с параметрами DatabaseConfig и закрывается при завершении потока.
+class ConnectionPool
+{
+public:
+    explicit ConnectionPool(const DatabaseConfig &config, int maxConnections);
+    ~ConnectionPool();
+
+    void run(std::function<void(SportsRepository &)> task);
+    void waitForDone();
+
+    // Справочник, который получают репозитории всех потоков пула
+    void setDictionary(const std::shared_ptr<const TeamDictionary> &dictionary);
+
+private:
+    struct PooledConnection;
+
+    SportsRepository *repositoryForCurrentThread();
+
+    DatabaseConfig config;
+    QMutex dictionaryMutex;
+    std::shared_ptr<const TeamDictionary> dictionary;
+    QThreadStorage<PooledConnection *> connections;
+    QThreadPool threadPool;
+};
+
+#endif // CONNECTIONPOOL_H
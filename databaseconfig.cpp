@@ -0,0 +1,109 @@
+#include "databaseconfig.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QFileInfo>
+#include <QUrl>
+#include <QDebug>
+
+namespace {
+
+int environmentInt(const char *name, int fallback)
+{
+    bool ok = false;
+    int value = qEnvironmentVariableIntValue(name, &ok);
+    return ok ? value : fallback;
+}
+
+QString pragmaValue(const QSqlDatabase &db, const QString &pragma)
+{
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA " + pragma) || !query.next()) {
+        return "?";
+    }
+    return query.value(0).toString();
+}
+
+bool execPragma(QSqlDatabase db, const QString &pragma)
+{
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA " + pragma)) {
+        qDebug() << "Ошибка PRAGMA" << pragma << ":" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+DatabaseConfig DatabaseConfig::fromEnvironment(const QString &path)
+{
+    DatabaseConfig config;
+    config.path = path;
+    config.readOnly = environmentInt("SPORTSTRACKER_DB_READONLY", 0) != 0;
+    config.immutable = environmentInt("SPORTSTRACKER_DB_IMMUTABLE", 1) != 0;
+    config.wal = environmentInt("SPORTSTRACKER_DB_WAL", 1) != 0;
+    config.mmapMb = qMax(0, environmentInt("SPORTSTRACKER_DB_MMAP_MB", config.mmapMb));
+    config.cacheMb = qMax(1, environmentInt("SPORTSTRACKER_DB_CACHE_MB", config.cacheMb));
+    return config;
+}
+
+bool DatabaseConfig::open(QSqlDatabase db, Access access) const
+{
+    if (writable(access)) {
+        // Пишущих соединений может быть несколько (приложение, приём событий):
+        // занятая БД ожидается, а не сразу возвращает SQLITE_BUSY
+        db.setDatabaseName(path);
+        db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+    } else {
+        // immutable=1 безопасен только когда писателя нет ни в одном процессе
+        QUrl url = QUrl::fromLocalFile(path);
+        url.setQuery(readOnly && immutable ? "mode=ro&immutable=1" : "mode=ro");
+        db.setDatabaseName(url.toString(QUrl::FullyEncoded));
+        db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI");
+    }
+
+    if (!db.open()) {
+        qDebug() << "Не удалось открыть БД" << path << ":" << db.lastError().text();
+        return false;
+    }
+
+    // Отрицательный cache_size задаётся в килобайтах, а не в страницах
+    execPragma(db, QString("mmap_size = %1").arg(qint64(mmapMb) * 1024 * 1024));
+    execPragma(db, QString("cache_size = %1").arg(-qint64(cacheMb) * 1024));
+    execPragma(db, "temp_store = MEMORY");
+
+    // WAL позволяет пулу читать, пока основное соединение пишет результаты
+    if (writable(access) && wal) {
+        execPragma(db, "journal_mode = WAL");
+        execPragma(db, "synchronous = NORMAL");
+    }
+    return true;
+}
+
+QStringList DatabaseConfig::diagnostics(const QSqlDatabase &db) const
+{
+    QStringList lines;
+    QFileInfo file(path);
+    lines << QString("Файл: %1 (%2 МБ)").arg(path).arg(file.size() / (1024.0 * 1024.0), 0, 'f', 1);
+    lines << QString("Режим: %1").arg(!readOnly ? "чтение и запись"
+                                                : immutable ? "только чтение, immutable"
+                                                            : "только чтение");
+    lines << QString("Строка подключения: %1").arg(db.databaseName());
+    lines << QString("Заказано: mmap %1 МБ, кеш %2 МБ, WAL %3")
+                 .arg(mmapMb).arg(cacheMb).arg(wal ? "да" : "нет");
+
+    if (!db.isOpen()) {
+        lines << "Соединение закрыто";
+        return lines;
+    }
+
+    lines << QString("journal_mode = %1").arg(pragmaValue(db, "journal_mode"));
+    lines << QString("mmap_size = %1").arg(pragmaValue(db, "mmap_size"));
+    lines << QString("cache_size = %1").arg(pragmaValue(db, "cache_size"));
+    lines << QString("page_size = %1").arg(pragmaValue(db, "page_size"));
+    lines << QString("page_count = %1").arg(pragmaValue(db, "page_count"));
+    lines << QString("freelist_count = %1").arg(pragmaValue(db, "freelist_count"));
+    lines << QString("query_only = %1").arg(pragmaValue(db, "query_only"));
+    lines << QString("user_version = %1").arg(pragmaValue(db, "user_version"));
+    return lines;
+}
@@ -0,0 +1,47 @@
+#ifndef DATABASECONFIG_H
+#define DATABASECONFIG_H
+
+#include <QSqlDatabase>
+#include <QStringList>
+
+// Параметры открытия SQLite, общие для всех соединений приложения.
+// По умолчанию основное соединение пишущее и переводит БД в WAL, а
+// соединения пула открываются только для чтения. В режиме только чтения
+// (SPORTSTRACKER_DB_READONLY=1) писателя нет: все соединения открываются
+// через URI с immutable=1, и SQLite не тратит время на блокировки и
+// проверку изменений файла.
+//
+// Переменные окружения:
+//   SPORTSTRACKER_DB_READONLY   1 — приложение не пишет в БД
+//   SPORTSTRACKER_DB_IMMUTABLE  0 — в режиме только чтения не объявлять файл неизменяемым
+//   SPORTSTRACKER_DB_MMAP_MB    размер отображения файла в память (0 — выключено)
+//   SPORTSTRACKER_DB_CACHE_MB   размер страничного кеша каждого соединения
+//   SPORTSTRACKER_DB_WAL        0 — не переводить БД в WAL
+struct DatabaseConfig
+{
+    enum Access {
+        ReadWrite,
+        ReadOnly
+    };
+
+    QString path;
+    bool readOnly = false;
+    bool immutable = true;          // действует только вместе с readOnly
+    bool wal = true;
+    int mmapMb = 256;
+    int cacheMb = 64;
+
+    static DatabaseConfig fromEnvironment(const QString &path);
+
+    // Открывает соединение с этими параметрами; ReadWrite в режиме
+    // только чтения всё равно открывает файл только для чтения
+    bool open(QSqlDatabase db, Access access) const;
+
+    // Действующие настройки соединения для диагностики
+    QStringList diagnostics(const QSqlDatabase &db) const;
+
+private:
+    bool writable(Access access) const { return !readOnly && access == ReadWrite; }
+};
+
+#endif // DATABASECONFIG_H
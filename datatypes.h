@@ -0,0 +1,349 @@
+#ifndef DATATYPES_H
+#define DATATYPES_H
+
+#include <QString>
+#include <QDate>
+#include <QVector>
+#include <QList>
+#include <QMetaType>
+#include <QVariant>
+#include <QStringList>
+
+// Простые структуры результатов, которые слой данных передаёт в интерфейс.
+// Не содержат ссылок на QSqlQuery и могут свободно пересекать границы потоков.
+
+struct SportRow
+{
+    int id = -1;
+    QString name;
+};
+
+struct TournamentRow
+{
+    int id = -1;
+    int sportId = -1;
+    QString name;
+};
+
+struct MatchListRow
+{
+    int id = -1;
+    QString date;       // как хранится в БД: "yyyy-MM-dd HH:mm:ss"
+    int team1Id = -1;
+    int team2Id = -1;
+    QString team1;
+    QString team2;
+    QString score;      // "-" если матч ещё не сыгран
+};
+
+// Счёт матча в целых числах (столбцы matches.home_goals / away_goals).
+// Отрицательные значения означают, что счёта нет или он не разобран.
+struct MatchResult
+{
+    qint16 homeGoals = -1;
+    qint16 awayGoals = -1;
+
+    bool isValid() const { return homeGoals >= 0 && awayGoals >= 0; }
+
+    // 1 — победа хозяев, 0 — ничья, -1 — победа гостей
+    int outcome() const { return homeGoals > awayGoals ? 1 : (homeGoals < awayGoals ? -1 : 0); }
+
+    QString toString() const
+    {
+        return isValid() ? QString("%1-%2").arg(homeGoals).arg(awayGoals) : QString();
+    }
+
+    static MatchResult fromColumns(const QVariant &home, const QVariant &away)
+    {
+        MatchResult result;
+        if (!home.isNull() && !away.isNull()) {
+            result.homeGoals = qint16(home.toInt());
+            result.awayGoals = qint16(away.toInt());
+        }
+        return result;
+    }
+
+    // Не больше стольких цифр в каждой части счёта: значение помещается в qint16
+    static constexpr int MaxGoalDigits = 4;
+
+    // Разбор текстового счёта "2-1"; нужен только для ввода, в БД счёт уже хранится числами.
+    // Те же правила применяет триггер БД (goalsSql в schemamigrator.cpp): каждая
+    // часть — от 1 до MaxGoalDigits цифр без знака, по краям допускаются пробелы
+    static MatchResult parse(const QString &score)
+    {
+        MatchResult result;
+        const QStringList parts = score.split('-');
+        if (parts.size() != 2) return result;
+
+        const int home = parseGoals(parts[0]);
+        const int away = parseGoals(parts[1]);
+        if (home >= 0 && away >= 0) {
+            result.homeGoals = qint16(home);
+            result.awayGoals = qint16(away);
+        }
+        return result;
+    }
+
+private:
+    static int parseGoals(QString part)
+    {
+        while (part.startsWith(' ')) part.remove(0, 1);
+        while (part.endsWith(' ')) part.chop(1);
+        if (part.isEmpty() || part.size() > MaxGoalDigits) return -1;
+        for (const QChar c : part) {
+            if (c.unicode() < '0' || c.unicode() > '9') return -1;
+        }
+        return part.toInt();
+    }
+};
+
+// Сводка по туру турнира, собираемая одним групповым запросом
+struct RoundInfo
+{
+    int round = 0;
+    int matchCount = 0;
+    int finishedCount = 0;
+    QString firstDate;
+    QString lastDate;
+};
+
+// Позиция в списке матчей для постраничной загрузки по ключу (date, id).
+// Следующая страница начинается строго после этой пары в порядке убывания.
+struct MatchPageCursor
+{
+    QString date;
+    int id = -1;
+
+    bool isValid() const { return id >= 0; }
+};
+
+// Зона места в таблице; границы зон задают правила вида спорта (sportrules.h)
+enum StandingZone {
+    NoZone,
+    PromotionZone,          // чемпионская лига, плей-офф
+    QualificationZone,      // остальные еврокубки
+    RelegationZone
+};
+
+struct StandingRow
+{
+    int position = 0;
+    StandingZone zone = NoZone;
+    int teamId = -1;
+    QString team;
+    int points = 0;
+    int played = 0;
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    int goalsFor = 0;
+    int goalsAgainst = 0;
+};
+
+// Вероятности итоговых мест команды по моделированию оставшихся матчей
+struct SeasonProjection
+{
+    int teamId = -1;
+    double title = 0.0;
+    double europe = 0.0;
+    double relegation = 0.0;
+    double expectedPoints = 0.0;
+};
+
+// Итоги игрока в турнире из агрегатной таблицы player_tournament_totals
+struct LeaderRow
+{
+    int playerId = -1;
+    int teamId = -1;
+    QString player;
+    QString team;
+    int goals = 0;
+    int assists = 0;
+    int yellowCards = 0;
+    int redCards = 0;
+};
+
+// Найденная полнотекстовым поиском команда, игрок, турнир или матч.
+// tournamentId и round указывают, куда перейти по результату: турнир
+// матча, сам турнир или последний турнир команды (игрока).
+struct SearchResult
+{
+    // Совпадает с остатком rowid в search_index: rowid = id * SearchKindCount + kind
+    enum Kind {
+        SearchTeam,
+        SearchPlayer,
+        SearchTournament,
+        SearchMatch,
+        SearchKindCount
+    };
+
+    Kind kind = SearchTeam;
+    int id = -1;
+    QString title;
+    QString subtitle;
+    int tournamentId = -1;
+    QString tournamentName;
+    int round = -1;
+};
+
+struct MatchHeader
+{
+    int id = -1;
+    int team1Id = -1;
+    int team2Id = -1;
+    QString team1;
+    QString team2;
+    QDate date;
+};
+
+struct StatRow
+{
+    QString name;
+    QString team1Value;
+    QString team2Value;
+};
+
+struct LineupEntry
+{
+    int teamId = -1;
+    QString jersey;
+    QString name;
+    QString position;
+    bool starting = true;
+};
+
+struct EventRow
+{
+    QString type;
+    int minute = 0;
+    QString player;     // пусто, если игрок не указан
+    QString description;
+    int teamId = -1;
+};
+
+struct HistoryRow
+{
+    QString date;
+    QString team1;
+    QString team2;
+    QString score;
+};
+
+struct MatchDetails
+{
+    MatchHeader header;
+    QVector<StatRow> stats;
+    QVector<LineupEntry> lineups;
+    QVector<EventRow> events;
+    QVector<HistoryRow> team1Recent;
+    QVector<HistoryRow> team2Recent;
+    QVector<HistoryRow> headToHead;
+};
+
+// Числовые значения одного показателя match_stats по всем матчам турнира,
+// упорядоченные по команде: i-е значение показала команда teamIds[i]
+struct TeamStatSamples
+{
+    QString stat;
+    QVector<int> teamIds;
+    QVector<double> values;
+};
+
+// Сезонные показатели команд турнира (TeamStatsCache). Значения хранятся
+// по столбцам: для показателя s и команды t — индекс s * teamIds.size() + t.
+struct TeamStatsTable
+{
+    int tournamentId = -1;
+    QVector<int> teamIds;
+    QStringList teams;
+    QStringList stats;
+    QVector<int> statTypes;             // StatCatalogue::ValueType
+    QVector<int> matches;               // матчей со значением показателя
+    QVector<double> sums;
+    QVector<double> means;
+    QVector<double> percentiles;        // место среднего команды среди команд турнира, 0–100
+    QVector<double> tournamentSums;     // по показателю
+    QVector<double> tournamentMeans;    // среднее за матч одной команды
+    QVector<double> tournamentMedians;
+
+    int cell(int stat, int team) const { return stat * teamIds.size() + team; }
+};
+
+// Свежие данные видимой части интерфейса после изменения БД другим
+// соединением: матчи тура, таблица турнира и, если открыт, ход матча.
+// Интерфейс сравнивает их с показанными и обновляет только изменившиеся строки.
+struct LiveUpdate
+{
+    int tournamentId = -1;
+    int round = -1;
+    QVector<MatchListRow> matches;
+    bool matchesComplete = false;   // matches содержит весь тур
+    QVector<StandingRow> standings;
+    int matchId = -1;
+    QVector<EventRow> events;
+    QVector<StatRow> stats;
+};
+
+// Сравнение строк, по которым интерфейс решает, нужно ли перестраивать
+// уже показанные данные (например, восстановленные из снимка навигации)
+inline bool operator==(const SportRow &a, const SportRow &b)
+{
+    return a.id == b.id && a.name == b.name;
+}
+
+inline bool operator==(const TournamentRow &a, const TournamentRow &b)
+{
+    return a.id == b.id && a.sportId == b.sportId && a.name == b.name;
+}
+
+inline bool operator==(const MatchListRow &a, const MatchListRow &b)
+{
+    return a.id == b.id && a.date == b.date && a.team1Id == b.team1Id && a.team2Id == b.team2Id
+           && a.team1 == b.team1 && a.team2 == b.team2 && a.score == b.score;
+}
+
+inline bool operator==(const EventRow &a, const EventRow &b)
+{
+    return a.type == b.type && a.minute == b.minute && a.player == b.player
+           && a.description == b.description && a.teamId == b.teamId;
+}
+
+inline bool operator==(const StatRow &a, const StatRow &b)
+{
+    return a.name == b.name && a.team1Value == b.team1Value && a.team2Value == b.team2Value;
+}
+
+inline bool operator==(const RoundInfo &a, const RoundInfo &b)
+{
+    return a.round == b.round && a.matchCount == b.matchCount && a.finishedCount == b.finishedCount
+           && a.firstDate == b.firstDate && a.lastDate == b.lastDate;
+}
+
+inline bool operator==(const StandingRow &a, const StandingRow &b)
+{
+    return a.position == b.position && a.zone == b.zone && a.teamId == b.teamId && a.team == b.team
+           && a.points == b.points && a.played == b.played && a.wins == b.wins
+           && a.draws == b.draws && a.losses == b.losses
+           && a.goalsFor == b.goalsFor && a.goalsAgainst == b.goalsAgainst;
+}
+
+Q_DECLARE_METATYPE(SportRow)
+Q_DECLARE_METATYPE(TournamentRow)
+Q_DECLARE_METATYPE(MatchListRow)
+Q_DECLARE_METATYPE(MatchPageCursor)
+Q_DECLARE_METATYPE(RoundInfo)
+Q_DECLARE_METATYPE(MatchResult)
+Q_DECLARE_METATYPE(SeasonProjection)
+Q_DECLARE_METATYPE(StandingRow)
+Q_DECLARE_METATYPE(LeaderRow)
+Q_DECLARE_METATYPE(LiveUpdate)
+Q_DECLARE_METATYPE(TeamStatsTable)
+Q_DECLARE_METATYPE(SearchResult)
+Q_DECLARE_METATYPE(MatchHeader)
+Q_DECLARE_METATYPE(StatRow)
+Q_DECLARE_METATYPE(LineupEntry)
+Q_DECLARE_METATYPE(EventRow)
+Q_DECLARE_METATYPE(HistoryRow)
+Q_DECLARE_METATYPE(MatchDetails)
+
+#endif // DATATYPES_H
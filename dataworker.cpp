@@ -0,0 +1,493 @@
+#include "dataworker.h"
+#include "sportsrepository.h"
+#include "connectionpool.h"
+#include "standingsengine.h"
+#include "teamdictionary.h"
+#include "seasonsimulator.h"
+#include "schemamigrator.h"
+#include "leaderboard.h"
+#include "teamstatscache.h"
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QMetaObject>
+#include <QThread>
+#include <QDebug>
+#include <utility>
+
+DataWorker::DataWorker(const DatabaseConfig &config, QObject *parent)
+    : QObject(parent),
+      config(config),
+      connectionName(QString("worker-%1").arg(reinterpret_cast<quintptr>(this))),
+      repository(nullptr),
+      pool(new ConnectionPool(config, qBound(2, QThread::idealThreadCount(), 6))),
+      standingsEngine(nullptr),
+      leaderboard(nullptr),
+      teamStats(nullptr),
+      changePoll(nullptr),
+      dataVersion(-1),
+      nextTicket(0)
+{
+    for (auto &ticket : latest) {
+        ticket.store(0);
+    }
+
+    qRegisterMetaType<QVector<SportRow>>("QVector<SportRow>");
+    qRegisterMetaType<QVector<TournamentRow>>("QVector<TournamentRow>");
+    qRegisterMetaType<QVector<MatchListRow>>("QVector<MatchListRow>");
+    qRegisterMetaType<QVector<StandingRow>>("QVector<StandingRow>");
+    qRegisterMetaType<QVector<RoundInfo>>("QVector<RoundInfo>");
+    qRegisterMetaType<MatchHeader>("MatchHeader");
+    qRegisterMetaType<QVector<StatRow>>("QVector<StatRow>");
+    qRegisterMetaType<QVector<LineupEntry>>("QVector<LineupEntry>");
+    qRegisterMetaType<QVector<EventRow>>("QVector<EventRow>");
+    qRegisterMetaType<QVector<HistoryRow>>("QVector<HistoryRow>");
+    qRegisterMetaType<MatchDetails>("MatchDetails");
+    qRegisterMetaType<QVector<SeasonProjection>>("QVector<SeasonProjection>");
+    qRegisterMetaType<QVector<SearchResult>>("QVector<SearchResult>");
+    qRegisterMetaType<QVector<LeaderRow>>("QVector<LeaderRow>");
+    qRegisterMetaType<LiveUpdate>("LiveUpdate");
+    qRegisterMetaType<TeamStatsTable>("TeamStatsTable");
+}
+
+DataWorker::~DataWorker()
+{
+    // Пул дожидается своих задач, которые ещё могут испускать сигналы воркера
+    delete pool;
+    closeDatabase();
+    delete standingsEngine;
+    delete leaderboard;
+    delete teamStats;
+}
+
+void DataWorker::openDatabase()
+{
+    if (repository) return;
+
+    // Соединение создаётся в потоке воркера и используется только в нём
+    QSqlDatabase workerDb = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    if (!config.open(workerDb, DatabaseConfig::ReadWrite)) {
+        qDebug() << "Воркер не смог открыть БД:" << workerDb.lastError().text();
+        emit databaseOpened(false, "Не удалось подключиться к базе данных");
+        return;
+    }
+
+    // Вместо чтения списка таблиц достаточно версии схемы из заголовка файла:
+    // актуальная версия означает, что все таблицы и индексы уже на месте.
+    // Старую схему обновляют миграции, а если таблиц нет, миграция не пройдёт
+    int version = SchemaMigrator::currentVersion(workerDb);
+    if (version < SchemaMigrator::latestVersion()) {
+        QString error;
+        if (config.readOnly) {
+            qDebug() << "Схема БД версии" << version << ", требуется" << SchemaMigrator::latestVersion();
+            error = "Схема базы данных устарела, а БД открыта только для чтения.\n"
+                    "Запустите приложение один раз без SPORTSTRACKER_DB_READONLY.";
+        } else if (!SchemaMigrator::migrate(workerDb)) {
+            error = "Не удалось обновить схему базы данных";
+        }
+        if (!error.isEmpty()) {
+            workerDb.close();
+            emit databaseOpened(false, error);
+            return;
+        }
+    }
+
+    if (!SchemaMigrator::verifyIndexUsage(workerDb)) {
+        qDebug() << "Запросы истории матчей выполняются без предназначенных индексов";
+    }
+
+    repository = new SportsRepository(workerDb);
+    loadDictionary();
+
+    // Изменения из других соединений замечаются опросом PRAGMA data_version:
+    // это чтение счётчика из памяти SQLite, без обращения к таблицам.
+    // sqlite3_update_hook здесь не помогает — пишут другие процессы.
+    // SPORTSTRACKER_LIVE_POLL_MS задаёт период опроса, 0 выключает его
+    dataVersion = repository->dataVersion();
+    bool ok = false;
+    int interval = qEnvironmentVariableIntValue("SPORTSTRACKER_LIVE_POLL_MS", &ok);
+    if (!ok) {
+        interval = 1000;
+    }
+    if (interval > 0) {
+        changePoll = new QTimer(this);
+        changePoll->setInterval(interval);
+        connect(changePoll, &QTimer::timeout, this, &DataWorker::checkDataVersion);
+        changePoll->start();
+    }
+
+    emit databaseOpened(true, QString());
+}
+
+void DataWorker::checkDataVersion()
+{
+    if (!repository) return;
+
+    qint64 version = repository->dataVersion();
+    if (version == dataVersion) return;
+    dataVersion = version;
+
+    // Таблица, собранная по старым результатам, пересобирается при следующем запросе,
+    // а справочник перечитывается: импорт и приём событий добавляют команды и игроков
+    delete standingsEngine;
+    standingsEngine = nullptr;
+    loadDictionary();
+    emit databaseChanged();
+}
+
+void DataWorker::loadDictionary()
+{
+    // Справочник не меняется после загрузки и читается всеми потоками; при
+    // изменении БД создаётся новый, а задачи, начатые со старым, дорабатывают с ним
+    auto dictionary = std::make_shared<TeamDictionary>();
+    if (!dictionary->load(repository->database())) return;
+
+    std::shared_ptr<const TeamDictionary> shared = dictionary;
+    repository->setDictionary(shared);
+    pool->setDictionary(shared);
+}
+
+void DataWorker::closeDatabase()
+{
+    // Таймер создан в потоке воркера и останавливается в нём же
+    delete changePoll;
+    changePoll = nullptr;
+
+    if (!repository) return;
+
+    repository->logStatementStats(connectionName);
+    delete repository;
+    repository = nullptr;
+
+    {
+        QSqlDatabase workerDb = QSqlDatabase::database(connectionName, false);
+        if (workerDb.isOpen()) {
+            workerDb.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+quint64 DataWorker::issue(Channel channel)
+{
+    quint64 ticket = ++nextTicket;
+    latest[channel].store(ticket);
+    return ticket;
+}
+
+bool DataWorker::isStale(Channel channel, quint64 ticket) const
+{
+    return latest[channel].load() != ticket;
+}
+
+void DataWorker::cancel(Channel channel)
+{
+    // Новый номер без задачи делает все ожидающие запросы канала устаревшими
+    issue(channel);
+}
+
+template <typename Func>
+void DataWorker::post(Func &&func)
+{
+    QMetaObject::invokeMethod(this, std::forward<Func>(func), Qt::QueuedConnection);
+}
+
+quint64 DataWorker::requestSports()
+{
+    quint64 ticket = issue(SportsChannel);
+    post([this, ticket]() {
+        if (!repository || isStale(SportsChannel, ticket)) return;
+        emit sportsLoaded(ticket, repository->sports());
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestTournaments(int sportId)
+{
+    // Турниры разных видов спорта загружаются независимо и не отменяют друг друга
+    quint64 ticket = ++nextTicket;
+    post([this, ticket, sportId]() {
+        if (!repository) return;
+        emit tournamentsLoaded(ticket, sportId, repository->tournaments(sportId));
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestRounds(int tournamentId)
+{
+    quint64 ticket = issue(RoundsChannel);
+    post([this, ticket, tournamentId]() {
+        if (!repository || isStale(RoundsChannel, ticket)) return;
+        emit roundsLoaded(ticket, tournamentId, repository->rounds(tournamentId));
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestMatchPage(int tournamentId, int round, const MatchPageCursor &after, int limit)
+{
+    quint64 ticket = issue(MatchesChannel);
+    post([this, ticket, tournamentId, round, after, limit]() {
+        if (!repository || isStale(MatchesChannel, ticket)) return;
+        QVector<MatchListRow> rows = repository->matchesPage(tournamentId, round, after, limit);
+        bool last = rows.size() < limit;
+        emit matchPageLoaded(ticket, rows, last);
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestStandings(int tournamentId)
+{
+    quint64 ticket = issue(StandingsChannel);
+    post([this, ticket, tournamentId]() {
+        if (!repository || isStale(StandingsChannel, ticket)) return;
+
+        emit standingsLoaded(ticket, standingsFor(tournamentId));
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestMatchResult(int tournamentId, int matchId, const MatchResult &result)
+{
+    quint64 ticket = issue(StandingsChannel);
+    post([this, ticket, tournamentId, matchId, result]() {
+        if (!repository) return;
+        if (config.readOnly) {
+            qDebug() << "БД открыта только для чтения, результат матча" << matchId << "не записан";
+            return;
+        }
+
+        // Результат записывается всегда; устаревшим может быть только обновление таблицы в интерфейсе
+        StandingsEngine *engine = engineFor(tournamentId);
+        if (!engine || !engine->recordResult(repository->database(), matchId, result)) return;
+        if (isStale(StandingsChannel, ticket)) return;
+        emit standingsLoaded(ticket, engine->rows());
+    });
+    return ticket;
+}
+
+StandingsEngine *DataWorker::engineFor(int tournamentId)
+{
+    if (!standingsEngine) {
+        standingsEngine = new StandingsEngine;
+    }
+
+    if (standingsEngine->tournamentId() != tournamentId
+        && !standingsEngine->load(repository->database(), tournamentId)) {
+        return nullptr;
+    }
+    return standingsEngine;
+}
+
+// Единственный источник таблицы для интерфейса, и при открытии турнира, и после
+// изменения БД: сохранённая таблица standings. Её пишут только запись результата
+// и приём событий; здесь таблица лишь считается по результатам матчей и
+// сохраняется, если для турнира её ещё нет
+QVector<StandingRow> DataWorker::standingsFor(int tournamentId)
+{
+    QVector<StandingRow> rows = repository->standings(tournamentId);
+    if (!rows.isEmpty()) return rows;
+
+    StandingsEngine *engine = engineFor(tournamentId);
+    if (engine) {
+        if (!config.readOnly) {
+            engine->save(repository->database());
+        }
+        rows = engine->rows();
+    }
+    return rows;
+}
+
+quint64 DataWorker::requestMatchDetails(const MatchHeader &header)
+{
+    quint64 ticket = issue(MatchDetailsChannel);
+
+    // Заголовок (id команд и дата) уже известен из списка матчей, поэтому
+    // все панели независимы: запускаем их одновременно, каждая на своём соединении.
+    // Перед выполнением задача проверяет, не выбрал ли пользователь уже другой матч.
+    pool->run([this, ticket, header](SportsRepository &repo) {
+        if (isStale(MatchDetailsChannel, ticket)) return;
+        emit matchStatsLoaded(ticket, repo.matchStats(header));
+    });
+    pool->run([this, ticket, header](SportsRepository &repo) {
+        if (isStale(MatchDetailsChannel, ticket)) return;
+        emit lineupsLoaded(ticket, repo.lineups(header));
+    });
+    pool->run([this, ticket, header](SportsRepository &repo) {
+        if (isStale(MatchDetailsChannel, ticket)) return;
+        emit eventsLoaded(ticket, repo.events(header));
+    });
+    pool->run([this, ticket, header](SportsRepository &repo) {
+        if (isStale(MatchDetailsChannel, ticket)) return;
+        emit recentMatchesLoaded(ticket, 1, repo.recentMatches(header.team1Id, header.date));
+    });
+    pool->run([this, ticket, header](SportsRepository &repo) {
+        if (isStale(MatchDetailsChannel, ticket)) return;
+        emit recentMatchesLoaded(ticket, 2, repo.recentMatches(header.team2Id, header.date));
+    });
+    pool->run([this, ticket, header](SportsRepository &repo) {
+        if (isStale(MatchDetailsChannel, ticket)) return;
+        emit headToHeadLoaded(ticket, repo.headToHead(header.team1Id, header.team2Id, header.date));
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestMatchPrefetch(const QVector<MatchHeader> &headers)
+{
+    quint64 ticket = issue(PrefetchChannel);
+
+    // Задачи встают в очередь пула после панелей открытого матча и не мешают им.
+    // Каждый соседний матч читается целиком одной задачей на одном соединении.
+    for (const MatchHeader &header : headers) {
+        pool->run([this, ticket, header](SportsRepository &repo) {
+            if (isStale(PrefetchChannel, ticket)) return;
+
+            MatchDetails details;
+            details.header = header;
+            details.stats = repo.matchStats(header);
+            details.lineups = repo.lineups(header);
+            details.events = repo.events(header);
+            details.team1Recent = repo.recentMatches(header.team1Id, header.date);
+            details.team2Recent = repo.recentMatches(header.team2Id, header.date);
+            details.headToHead = repo.headToHead(header.team1Id, header.team2Id, header.date);
+
+            // Уже прочитанные данные отдаём даже для устаревшего запроса: они пригодятся кэшу
+            emit matchDetailsPrefetched(ticket, details);
+        });
+    }
+    return ticket;
+}
+
+quint64 DataWorker::requestRoundPrefetch(int tournamentId, const QList<int> &rounds, int limit)
+{
+    quint64 ticket = issue(RoundPrefetchChannel);
+
+    for (int round : rounds) {
+        pool->run([this, ticket, tournamentId, round, limit](SportsRepository &repo) {
+            if (isStale(RoundPrefetchChannel, ticket)) return;
+            QVector<MatchListRow> rows = repo.matchesPage(tournamentId, round, MatchPageCursor(), limit);
+            bool complete = rows.size() < limit;
+            emit roundPrefetched(ticket, tournamentId, round, rows, complete);
+        });
+    }
+    return ticket;
+}
+
+quint64 DataWorker::requestSeasonProjection(int tournamentId, int iterations)
+{
+    quint64 ticket = issue(ProjectionChannel);
+
+    // Задача занимает один поток пула только на чтение данных и ожидание:
+    // сами прогоны выполняет SeasonSimulator в своих потоках по числу ядер
+    pool->run([this, ticket, tournamentId, iterations](SportsRepository &repo) {
+        if (isStale(ProjectionChannel, ticket)) return;
+
+        // Таблица пересчитывается по тем же матчам, из которых берутся оставшиеся
+        StandingsEngine engine;
+        SeasonSimulator simulator;
+        if (!engine.load(repo.database(), tournamentId)
+            || !simulator.load(repo.database(), tournamentId, engine.sportKind(), engine.rows())) {
+            return;
+        }
+
+        QVector<SeasonProjection> rows = simulator.run(iterations, [this, ticket]() {
+            return isStale(ProjectionChannel, ticket);
+        });
+        if (isStale(ProjectionChannel, ticket)) return;
+        emit seasonProjectionLoaded(ticket, tournamentId, rows);
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestLiveRefresh(int tournamentId, int round, const MatchHeader &match, int limit)
+{
+    quint64 ticket = issue(LiveChannel);
+    post([this, ticket, tournamentId, round, match, limit]() {
+        if (!repository || isStale(LiveChannel, ticket)) return;
+
+        LiveUpdate update;
+        update.tournamentId = tournamentId;
+        update.round = round;
+        update.matches = repository->matchesPage(tournamentId, round, MatchPageCursor(), limit);
+        update.matchesComplete = update.matches.size() < limit;
+
+        // Из того же источника, что и при открытии турнира
+        update.standings = standingsFor(tournamentId);
+
+        if (match.id != -1) {
+            update.matchId = match.id;
+            update.events = repository->events(match);
+            update.stats = repository->matchStats(match);
+        }
+
+        emit liveRefreshed(ticket, update);
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestLeaders(int tournamentId, int category, int count)
+{
+    quint64 ticket = issue(LeadersChannel);
+    post([this, ticket, tournamentId, category, count]() {
+        if (!repository || isStale(LeadersChannel, ticket)) return;
+        if (category < 0 || category >= Leaderboard::CategoryCount) return;
+
+        // Итоги турнира перечитываются, только если открыт другой турнир или
+        // другое соединение (импорт, приём событий) изменило БД
+        if (!leaderboard) {
+            leaderboard = new Leaderboard;
+        }
+        qint64 version = repository->dataVersion();
+        if (leaderboard->tournamentId() != tournamentId || leaderboard->dataVersion() != version) {
+            leaderboard->setRows(tournamentId, version, repository->playerTotals(tournamentId));
+        }
+
+        emit leadersLoaded(ticket, tournamentId, category,
+                           leaderboard->top(Leaderboard::Category(category), count));
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestTeamStats(int tournamentId)
+{
+    quint64 ticket = issue(TeamStatsChannel);
+    post([this, ticket, tournamentId]() {
+        if (!repository || isStale(TeamStatsChannel, ticket)) return;
+
+        // Как и итоги игроков, пересчитываются только для другого турнира или изменённой БД
+        if (!teamStats) {
+            teamStats = new TeamStatsCache;
+        }
+        qint64 version = repository->dataVersion();
+        if (teamStats->tournamentId() != tournamentId || teamStats->dataVersion() != version) {
+            teamStats->build(tournamentId, version, repository->teamStatSamples(tournamentId),
+                             *repository->dictionary());
+        }
+
+        emit teamStatsLoaded(ticket, teamStats->table());
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestSearch(const QString &text, int limit)
+{
+    quint64 ticket = issue(SearchChannel);
+
+    // Запрос, уже выполняющийся в SQLite, не прерывается, но его результат
+    // отбрасывается: интерфейс получает только ответ на последний набранный текст
+    pool->run([this, ticket, text, limit](SportsRepository &repo) {
+        if (isStale(SearchChannel, ticket)) return;
+        QVector<SearchResult> rows = repo.search(text, limit);
+        if (isStale(SearchChannel, ticket)) return;
+        emit searchResultsLoaded(ticket, text, rows);
+    });
+    return ticket;
+}
+
+quint64 DataWorker::requestDiagnostics()
+{
+    quint64 ticket = issue(DiagnosticsChannel);
+    post([this, ticket]() {
+        if (!repository || isStale(DiagnosticsChannel, ticket)) return;
+        emit diagnosticsLoaded(ticket, config.diagnostics(repository->database()));
+    });
+    return ticket;
+}
@@ -0,0 +1,129 @@
+#ifndef DATAWORKER_H
+#define DATAWORKER_H
+
+#include "datatypes.h"
+#include "databaseconfig.h"
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <atomic>
+
+class SportsRepository;
+class ConnectionPool;
+class StandingsEngine;
+class Leaderboard;
+class TeamStatsCache;
+
+// Выполняет запросы к БД в отдельном потоке со своим соединением.
+// Методы request*() можно вызывать из GUI-потока: каждый возвращает номер
+// запроса (ticket), с которым потом приходит сигнал с результатом.
+// Новый запрос того же канала отменяет предыдущий: устаревшие запросы
+// пропускаются воркером, не доходя до SQL.
+// Панели страницы матча загружаются параллельно через пул соединений,
+// и каждая приходит своим сигналом по мере готовности.
+class DataWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Channel {
+        SportsChannel,
+        TournamentsChannel,
+        RoundsChannel,
+        MatchesChannel,
+        StandingsChannel,
+        MatchDetailsChannel,
+        PrefetchChannel,
+        RoundPrefetchChannel,
+        ProjectionChannel,
+        DiagnosticsChannel,
+        SearchChannel,
+        LeadersChannel,
+        LiveChannel,
+        TeamStatsChannel,
+        ChannelCount
+    };
+
+    explicit DataWorker(const DatabaseConfig &config, QObject *parent = nullptr);
+    ~DataWorker();
+
+    quint64 requestSports();
+    quint64 requestTournaments(int sportId);
+    quint64 requestRounds(int tournamentId);
+    quint64 requestMatchPage(int tournamentId, int round, const MatchPageCursor &after, int limit);
+    quint64 requestStandings(int tournamentId);
+    quint64 requestMatchResult(int tournamentId, int matchId, const MatchResult &result);
+    quint64 requestMatchDetails(const MatchHeader &header);
+    // Фоновая загрузка страниц соседних матчей; новый вызов отменяет прежний
+    quint64 requestMatchPrefetch(const QVector<MatchHeader> &headers);
+    // Фоновая загрузка матчей соседних туров целиком, не больше limit строк на тур
+    quint64 requestRoundPrefetch(int tournamentId, const QList<int> &rounds, int limit);
+    // Вероятности мест по iterations прогонам оставшейся части сезона
+    quint64 requestSeasonProjection(int tournamentId, int iterations);
+    // Перечитывает видимые тур, таблицу и матч (match.id == -1, если не открыт)
+    // после сигнала databaseChanged; в туре не больше limit матчей
+    quint64 requestLiveRefresh(int tournamentId, int round, const MatchHeader &match, int limit);
+    // Лучшие count игроков турнира по категории Leaderboard::Category
+    quint64 requestLeaders(int tournamentId, int category, int count);
+    // Сезонные показатели команд турнира из match_stats (TeamStatsCache)
+    quint64 requestTeamStats(int tournamentId);
+    // Полнотекстовый поиск на соединении пула; новый запрос отменяет прежний
+    quint64 requestSearch(const QString &text, int limit);
+    // Действующие параметры соединения воркера (DatabaseConfig::diagnostics)
+    quint64 requestDiagnostics();
+
+    void cancel(Channel channel);
+
+public slots:
+    // Открывает БД и при необходимости обновляет схему; итог приходит сигналом databaseOpened
+    void openDatabase();
+    void closeDatabase();
+
+signals:
+    void databaseOpened(bool ok, const QString &error);
+    // БД изменило другое соединение (импорт, приём событий): PRAGMA data_version
+    void databaseChanged();
+    void liveRefreshed(quint64 ticket, const LiveUpdate &update);
+    void sportsLoaded(quint64 ticket, const QVector<SportRow> &rows);
+    void tournamentsLoaded(quint64 ticket, int sportId, const QVector<TournamentRow> &rows);
+    void roundsLoaded(quint64 ticket, int tournamentId, const QVector<RoundInfo> &rounds);
+    void matchPageLoaded(quint64 ticket, const QVector<MatchListRow> &rows, bool last);
+    void standingsLoaded(quint64 ticket, const QVector<StandingRow> &rows);
+    void matchStatsLoaded(quint64 ticket, const QVector<StatRow> &stats);
+    void lineupsLoaded(quint64 ticket, const QVector<LineupEntry> &lineups);
+    void eventsLoaded(quint64 ticket, const QVector<EventRow> &events);
+    void recentMatchesLoaded(quint64 ticket, int side, const QVector<HistoryRow> &rows);
+    void headToHeadLoaded(quint64 ticket, const QVector<HistoryRow> &rows);
+    void matchDetailsPrefetched(quint64 ticket, const MatchDetails &details);
+    void roundPrefetched(quint64 ticket, int tournamentId, int round,
+                         const QVector<MatchListRow> &rows, bool complete);
+    void seasonProjectionLoaded(quint64 ticket, int tournamentId, const QVector<SeasonProjection> &rows);
+    void diagnosticsLoaded(quint64 ticket, const QStringList &lines);
+    void leadersLoaded(quint64 ticket, int tournamentId, int category, const QVector<LeaderRow> &rows);
+    void teamStatsLoaded(quint64 ticket, const TeamStatsTable &table);
+    void searchResultsLoaded(quint64 ticket, const QString &text, const QVector<SearchResult> &rows);
+
+private:
+    quint64 issue(Channel channel);
+    bool isStale(Channel channel, quint64 ticket) const;
+    template <typename Func> void post(Func &&func);
+    StandingsEngine *engineFor(int tournamentId);
+    QVector<StandingRow> standingsFor(int tournamentId);
+    void checkDataVersion();
+    void loadDictionary();
+
+    DatabaseConfig config;
+    QString connectionName;
+    SportsRepository *repository;
+    ConnectionPool *pool;
+    StandingsEngine *standingsEngine;
+    Leaderboard *leaderboard;       // итоги игроков последнего запрошенного турнира
+    TeamStatsCache *teamStats;      // показатели команд последнего запрошенного турнира
+    QTimer *changePoll;             // опрос PRAGMA data_version в потоке воркера
+    qint64 dataVersion;
+    std::atomic<quint64> nextTicket;
+    std::atomic<quint64> latest[ChannelCount];
+};
+
+#endif // DATAWORKER_H
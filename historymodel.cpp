@@ -0,0 +1,53 @@
+#include "historymodel.h"
+
+HistoryModel::HistoryModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void HistoryModel::setRows(const QVector<HistoryRow> &newRows)
+{
+    beginResetModel();
+    rows = newRows;
+    endResetModel();
+}
+
+void HistoryModel::clear()
+{
+    setRows(QVector<HistoryRow>());
+}
+
+int HistoryModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+int HistoryModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 4;
+}
+
+QVariant HistoryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size() || role != Qt::DisplayRole) return QVariant();
+
+    const HistoryRow &row = rows.at(index.row());
+    switch (index.column()) {
+    case 0: return row.date;
+    case 1: return row.team1;
+    case 2: return row.team2;
+    case 3: return row.score;
+    }
+    return QVariant();
+}
+
+QVariant HistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    static const char *headers[] = {"Дата", "Команда 1", "Команда 2", "Счет"};
+    if (section < 0 || section >= 4) return QVariant();
+    return QString::fromUtf8(headers[section]);
+}
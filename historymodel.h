@@ -0,0 +1,28 @@
+#ifndef HISTORYMODEL_H
+#define HISTORYMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractTableModel>
+
+// Последние матчи команды или история очных встреч.
+class HistoryModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit HistoryModel(QObject *parent = nullptr);
+
+    void setRows(const QVector<HistoryRow> &rows);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QVector<HistoryRow> rows;
+};
+
+#endif // HISTORYMODEL_H
@@ -0,0 +1,113 @@
+#include "bulkimporter.h"
+#include "schemamigrator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QDir>
+#include <QDebug>
+
+// Консольная загрузка данных сезона в sports.db:
+//   sportstracker-import --db sports.db --matches season.csv --events events.ndjson
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("sportstracker-import");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Массовая загрузка матчей, составов, событий и статистики в БД SportsTracker");
+    parser.addHelpOption();
+
+    QCommandLineOption dbOption("db", "Путь к файлу БД.", "path",
+                                QDir::homePath() + "/database/sports.db");
+    QCommandLineOption batchOption("batch", "Строк в одной транзакции.", "rows", "100000");
+    QCommandLineOption keepIndexesOption("keep-indexes",
+                                         "Не удалять вторичные индексы на время загрузки.");
+    parser.addOption(dbOption);
+    parser.addOption(batchOption);
+    parser.addOption(keepIndexesOption);
+
+    // Имя опции совпадает с сокращённым именем таблицы; файлов может быть несколько
+    const QList<QPair<QString, QString>> sources = {
+        {"teams", "teams"},
+        {"players", "players"},
+        {"matches", "matches"},
+        {"lineups", "match_lineups"},
+        {"events", "match_events"},
+        {"stats", "match_stats"},
+    };
+    for (const auto &source : sources) {
+        parser.addOption(QCommandLineOption(source.first,
+            QString("Файл CSV/NDJSON для таблицы %1.").arg(source.second), "file"));
+    }
+    parser.process(app);
+
+    QTextStream out(stdout);
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(parser.value(dbOption));
+    if (!db.open()) {
+        qDebug() << "Не удалось открыть БД:" << db.lastError().text();
+        return 1;
+    }
+
+    // Схема приводится к последней версии до загрузки: триггеры миграций
+    // заполняют производные столбцы вставляемых строк
+    if (!SchemaMigrator::migrate(db)) {
+        return 1;
+    }
+
+    QList<QPair<QString, QString>> jobs;   // таблица, файл
+    QStringList tables;
+    for (const auto &source : sources) {
+        for (const QString &path : parser.values(source.first)) {
+            jobs.append(qMakePair(source.second, path));
+            if (!tables.contains(source.second)) tables.append(source.second);
+        }
+    }
+    if (jobs.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    BulkImporter importer(db);
+    importer.setBatchSize(parser.value(batchOption).toInt());
+    importer.setDeferIndexes(!parser.isSet(keepIndexesOption));
+
+    QElapsedTimer total;
+    total.start();
+    quint64 totalRows = 0;
+    bool ok = importer.begin(tables);
+
+    for (const auto &job : jobs) {
+        if (!ok) break;
+
+        BulkImporter::Report report;
+        ok = importer.importFile(job.first, job.second, &report);
+        totalRows += report.rows;
+        out << QString("%1 <- %2: %3 строк за %4 с (%5 строк/с), отклонено %6")
+                   .arg(report.table, report.path)
+                   .arg(report.rows)
+                   .arg(report.elapsedMs / 1000.0, 0, 'f', 2)
+                   .arg(report.rowsPerSecond(), 0, 'f', 0)
+                   .arg(report.rejected)
+            << Qt::endl;
+    }
+
+    QElapsedTimer indexTimer;
+    indexTimer.start();
+    ok = importer.finish() && ok;
+    out << QString("Индексы и ANALYZE: %1 с").arg(indexTimer.elapsed() / 1000.0, 0, 'f', 2) << Qt::endl;
+
+    double seconds = total.elapsed() / 1000.0;
+    out << QString("Итого: %1 строк за %2 с (%3 строк/с)")
+               .arg(totalRows)
+               .arg(seconds, 0, 'f', 2)
+               .arg(seconds > 0 ? totalRows / seconds : double(totalRows), 0, 'f', 0)
+        << Qt::endl;
+
+    db.close();
+    return ok ? 0 : 1;
+}
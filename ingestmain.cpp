@@ -0,0 +1,114 @@
+#include "liveingestor.h"
+#include "databaseconfig.h"
+#include "schemamigrator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSqlDatabase>
+#include <QTextStream>
+#include <QTimer>
+#include <QDir>
+#include <QDebug>
+
+namespace {
+
+void printStats(QTextStream &out, const LiveIngestor::Stats &stats)
+{
+    out << QString("Принято %1, отклонено %2, партий %3 (средняя %4 строк, ошибок %5), "
+                   "запись %6 мс, макс. задержка %7 мс")
+               .arg(stats.accepted)
+               .arg(stats.rejected)
+               .arg(stats.batches)
+               .arg(stats.batches ? double(stats.accepted) / stats.batches : 0.0, 0, 'f', 1)
+               .arg(stats.failedBatches)
+               .arg(stats.writeMs)
+               .arg(stats.maxLatencyMs)
+        << Qt::endl;
+}
+
+} // namespace
+
+// Приём живых событий матчей в sports.db:
+//   sportstracker-ingest --db sports.db --socket sportstracker-live
+//   sportstracker-ingest --db sports.db --file feed.ndjson --follow
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("sportstracker-ingest");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Приём событий, счёта и статистики живых матчей в БД SportsTracker");
+    parser.addHelpOption();
+
+    QCommandLineOption dbOption("db", "Путь к файлу БД.", "path",
+                                QDir::homePath() + "/database/sports.db");
+    QCommandLineOption socketOption("socket", "Имя локального сокета, из которого читать строки NDJSON.", "name");
+    QCommandLineOption fileOption("file", "Файл NDJSON с событиями.", "path");
+    QCommandLineOption followOption("follow", "Ждать новых строк в файле, как tail -f.");
+    QCommandLineOption batchOption("batch", "Наибольшее число строк в одной транзакции.", "rows", "2000");
+    QCommandLineOption delayOption("delay-ms", "Наибольшая задержка записи строки, мс.", "ms", "100");
+    QCommandLineOption reportOption("report", "Выводить счётчики каждые N секунд (0 — только в конце).", "seconds", "10");
+    parser.addOption(dbOption);
+    parser.addOption(socketOption);
+    parser.addOption(fileOption);
+    parser.addOption(followOption);
+    parser.addOption(batchOption);
+    parser.addOption(delayOption);
+    parser.addOption(reportOption);
+    parser.process(app);
+
+    if (parser.isSet(socketOption) == parser.isSet(fileOption)) {
+        parser.showHelp(1);
+    }
+
+    QTextStream out(stdout);
+
+    // Пишущее соединение: WAL и synchronous=NORMAL, чтобы частые короткие
+    // транзакции не ждали fsync и не мешали читателям приложения
+    DatabaseConfig config = DatabaseConfig::fromEnvironment(parser.value(dbOption));
+    if (config.readOnly) {
+        qDebug() << "Приём событий невозможен в режиме только для чтения";
+        return 1;
+    }
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    if (!config.open(db, DatabaseConfig::ReadWrite)) {
+        return 1;
+    }
+    // Триггеры миграций пересчитывают голы матчей, итоги игроков и поисковый индекс
+    if (!SchemaMigrator::migrate(db)) {
+        return 1;
+    }
+
+    int exitCode = 0;
+    {
+        LiveIngestor ingestor(db);
+        ingestor.setBatchLimits(parser.value(batchOption).toInt(), parser.value(delayOption).toInt());
+
+        bool ok = parser.isSet(socketOption)
+                      ? ingestor.listen(parser.value(socketOption))
+                      : ingestor.readFile(parser.value(fileOption), parser.isSet(followOption));
+        if (!ok) {
+            return 1;
+        }
+
+        QTimer reportTimer;
+        const int reportSeconds = parser.value(reportOption).toInt();
+        if (reportSeconds > 0) {
+            QObject::connect(&reportTimer, &QTimer::timeout, [&]() { printStats(out, ingestor.stats()); });
+            reportTimer.start(reportSeconds * 1000);
+        }
+
+        QObject::connect(&ingestor, &LiveIngestor::finished, &app, &QCoreApplication::quit);
+        exitCode = app.exec();
+
+        ingestor.flush();
+        printStats(out, ingestor.stats());
+        if (ingestor.stats().failedBatches > 0) {
+            exitCode = 1;
+        }
+    }
+
+    db.close();
+    return exitCode;
+}
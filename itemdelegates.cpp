@@ -0,0 +1,74 @@
+#include "itemdelegates.h"
+#include "apptheme.h"
+#include "standingsmodel.h"
+#include "matchstatsmodel.h"
+#include "lineupsmodel.h"
+
+#include <QPainter>
+
+namespace {
+
+// Ширина метки зоны слева от позиции
+const int ZoneMarkWidth = 4;
+
+// Высота полосы доли команды под значением показателя
+const int ShareBarHeight = 4;
+
+} // namespace
+
+void StandingsDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                              const QModelIndex &index) const
+{
+    QColor zoneColor;
+    switch (index.data(StandingsModel::ZoneRole).toInt()) {
+    case PromotionZone: zoneColor = AppTheme::promotionZone(); break;
+    case QualificationZone: zoneColor = AppTheme::qualificationZone(); break;
+    case RelegationZone: zoneColor = AppTheme::relegationZone(); break;
+    }
+
+    if (zoneColor.isValid()) {
+        painter->fillRect(option.rect, zoneColor);
+        if (index.column() == StandingsModel::PositionColumn) {
+            QRect mark = option.rect;
+            mark.setWidth(ZoneMarkWidth);
+            painter->fillRect(mark, zoneColor.darker(130));
+        }
+    }
+
+    QStyledItemDelegate::paint(painter, option, index);
+}
+
+void MatchStatsDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                               const QModelIndex &index) const
+{
+    const QVariant share = index.data(MatchStatsModel::ShareRole);
+    if (share.isValid()) {
+        // Полоса прижата к середине строки: у первой команды к правому краю ячейки
+        const int width = qRound(option.rect.width() * share.toDouble());
+        QRect bar(option.rect.left(), option.rect.bottom() - ShareBarHeight, width, ShareBarHeight);
+        if (index.column() == MatchStatsModel::Team1Column) {
+            bar.moveRight(option.rect.right());
+        }
+        painter->fillRect(bar, share.toDouble() >= 0.5 ? AppTheme::accent() : AppTheme::accentLight());
+    }
+
+    QStyledItemDelegate::paint(painter, option, index);
+}
+
+void LineupDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                           const QModelIndex &index) const
+{
+    if (index.data(LineupsModel::SectionRole).toBool()) {
+        painter->fillRect(option.rect, AppTheme::sectionBackground());
+    }
+
+    QStyledItemDelegate::paint(painter, option, index);
+
+    if (!index.data(LineupsModel::SectionRole).toBool()
+        && index.column() == LineupsModel::Team1Column) {
+        painter->save();
+        painter->setPen(AppTheme::border());
+        painter->drawLine(option.rect.topRight(), option.rect.bottomRight());
+        painter->restore();
+    }
+}
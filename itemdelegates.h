@@ -0,0 +1,47 @@
+#ifndef ITEMDELEGATES_H
+#define ITEMDELEGATES_H
+
+#include <QStyledItemDelegate>
+
+// Делегаты рисуют оформление ячеек сами, цветами AppTheme, вместо таблиц
+// стилей и QTableWidgetItem с заданными шрифтами и фоном.
+
+// Фон строки по зоне турнирной таблицы (StandingsModel::ZoneRole)
+// и цветная метка зоны у столбца позиции.
+class StandingsDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+};
+
+// Двусторонняя строка статистики матча: за значением каждой команды
+// полоса её доли (MatchStatsModel::ShareRole), растущая от середины.
+class MatchStatsDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+};
+
+// Составы: заголовки разделов на сером фоне, между колонками команд разделитель.
+class LineupDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+};
+
+#endif // ITEMDELEGATES_H
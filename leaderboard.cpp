@@ -0,0 +1,70 @@
+#include "leaderboard.h"
+#include <algorithm>
+#include <vector>
+
+void Leaderboard::setRows(int tournamentId, qint64 dataVersion, const QVector<LeaderRow> &newRows)
+{
+    tournament = tournamentId;
+    version = dataVersion;
+    rows = newRows;
+}
+
+int Leaderboard::value(const LeaderRow &row, Category category)
+{
+    switch (category) {
+    case Goals: return row.goals;
+    case Assists: return row.assists;
+    case YellowCards: return row.yellowCards;
+    case RedCards: return row.redCards;
+    case CategoryCount: break;
+    }
+    return 0;
+}
+
+QString Leaderboard::categoryName(Category category)
+{
+    switch (category) {
+    case Goals: return "Голы";
+    case Assists: return "Голевые передачи";
+    case YellowCards: return "Жёлтые карточки";
+    case RedCards: return "Красные карточки";
+    case CategoryCount: break;
+    }
+    return QString();
+}
+
+QVector<LeaderRow> Leaderboard::top(Category category, int count) const
+{
+    // Лучше тот, у кого больше значение; при равенстве — по имени игрока
+    auto better = [this, category](int a, int b) {
+        int valueA = value(rows[a], category);
+        int valueB = value(rows[b], category);
+        if (valueA != valueB) return valueA > valueB;
+        return rows[a].player < rows[b].player;
+    };
+
+    // На вершине кучи худший из отобранных: новый игрок вытесняет его,
+    // только если лучше. Проход по всем игрокам — O(P log N)
+    std::vector<int> heap;
+    heap.reserve(count + 1);
+    for (int i = 0; i < rows.size() && count > 0; ++i) {
+        if (value(rows[i], category) <= 0) continue;
+
+        if (int(heap.size()) < count) {
+            heap.push_back(i);
+            std::push_heap(heap.begin(), heap.end(), better);
+        } else if (better(i, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = i;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), better);
+
+    QVector<LeaderRow> result;
+    result.reserve(int(heap.size()));
+    for (int index : heap) {
+        result.append(rows[index]);
+    }
+    return result;
+}
@@ -0,0 +1,37 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "datatypes.h"
+
+// Лидеры турнира по голам, передачам и карточкам. Итоги игроков читаются
+// из агрегатной таблицы целиком (их сотни, а не миллионы событий), а лучшие
+// N по любой категории отбираются в памяти кучей размера N.
+class Leaderboard
+{
+public:
+    enum Category {
+        Goals,
+        Assists,
+        YellowCards,
+        RedCards,
+        CategoryCount
+    };
+
+    void setRows(int tournamentId, qint64 dataVersion, const QVector<LeaderRow> &rows);
+
+    int tournamentId() const { return tournament; }
+    qint64 dataVersion() const { return version; }
+
+    // Игроки с ненулевым значением категории по убыванию, не больше count
+    QVector<LeaderRow> top(Category category, int count) const;
+
+    static int value(const LeaderRow &row, Category category);
+    static QString categoryName(Category category);
+
+private:
+    int tournament = -1;
+    qint64 version = -1;
+    QVector<LeaderRow> rows;
+};
+
+#endif // LEADERBOARD_H
@@ -0,0 +1,64 @@
+#include "leadersmodel.h"
+
+LeadersModel::LeadersModel(QObject *parent)
+    : QAbstractTableModel(parent),
+      category(Leaderboard::Goals)
+{
+}
+
+void LeadersModel::setRows(Leaderboard::Category newCategory, const QVector<LeaderRow> &newRows)
+{
+    beginResetModel();
+    category = newCategory;
+    rows = newRows;
+    endResetModel();
+}
+
+void LeadersModel::clear()
+{
+    setRows(category, QVector<LeaderRow>());
+}
+
+int LeadersModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+int LeadersModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 4;
+}
+
+QVariant LeadersModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+
+    if (role == Qt::TextAlignmentRole) {
+        return index.column() == 1 || index.column() == 2 ? QVariant() : QVariant(Qt::AlignCenter);
+    }
+    if (role != Qt::DisplayRole) return QVariant();
+
+    const LeaderRow &row = rows.at(index.row());
+    switch (index.column()) {
+    case 0: return index.row() + 1;
+    case 1: return row.player;
+    case 2: return row.team;
+    case 3: return Leaderboard::value(row, category);
+    }
+    return QVariant();
+}
+
+QVariant LeadersModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case 0: return "#";
+    case 1: return "Игрок";
+    case 2: return "Команда";
+    case 3: return Leaderboard::categoryName(category);
+    }
+    return QVariant();
+}
@@ -0,0 +1,30 @@
+#ifndef LEADERSMODEL_H
+#define LEADERSMODEL_H
+
+#include "datatypes.h"
+#include "leaderboard.h"
+
+#include <QAbstractTableModel>
+
+// Лидеры турнира по одной категории: место, игрок, команда и значение.
+class LeadersModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit LeadersModel(QObject *parent = nullptr);
+
+    void setRows(Leaderboard::Category category, const QVector<LeaderRow> &rows);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    Leaderboard::Category category;
+    QVector<LeaderRow> rows;
+};
+
+#endif // LEADERSMODEL_H
@@ -0,0 +1,101 @@
+#include "lineupsmodel.h"
+#include <QFont>
+
+namespace {
+
+QString playerText(const LineupEntry *entry)
+{
+    return entry->jersey + " " + entry->name + " (" + entry->position + ")";
+}
+
+} // namespace
+
+LineupsModel::LineupsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void LineupsModel::setLineups(const MatchHeader &header, const QVector<LineupEntry> &lineups)
+{
+    // Разделяем составы обеих команд на основных и запасных
+    QVector<const LineupEntry *> team1Starters;
+    QVector<const LineupEntry *> team1Substitutes;
+    QVector<const LineupEntry *> team2Starters;
+    QVector<const LineupEntry *> team2Substitutes;
+
+    for (const LineupEntry &entry : lineups) {
+        if (entry.teamId == header.team1Id) {
+            (entry.starting ? team1Starters : team1Substitutes).append(&entry);
+        } else if (entry.teamId == header.team2Id) {
+            (entry.starting ? team2Starters : team2Substitutes).append(&entry);
+        }
+    }
+
+    beginResetModel();
+    rows.clear();
+    if (header.id != -1) {
+        appendSection("Основной состав", team1Starters, team2Starters);
+        appendSection("Запасной состав", team1Substitutes, team2Substitutes);
+    }
+    endResetModel();
+}
+
+void LineupsModel::appendSection(const QString &title,
+                                 const QVector<const LineupEntry *> &team1Players,
+                                 const QVector<const LineupEntry *> &team2Players)
+{
+    Row sectionRow;
+    sectionRow.section = true;
+    sectionRow.team1 = title;
+    rows.append(sectionRow);
+
+    const int count = qMax(team1Players.size(), team2Players.size());
+    for (int i = 0; i < count; ++i) {
+        Row row;
+        if (i < team1Players.size()) row.team1 = playerText(team1Players[i]);
+        if (i < team2Players.size()) row.team2 = playerText(team2Players[i]);
+        rows.append(row);
+    }
+}
+
+void LineupsModel::clear()
+{
+    setLineups(MatchHeader(), QVector<LineupEntry>());
+}
+
+int LineupsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+int LineupsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant LineupsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+
+    const Row &row = rows.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        if (row.section) return index.column() == Team1Column ? row.team1 : QString();
+        return index.column() == Team1Column ? row.team1 : row.team2;
+    case Qt::TextAlignmentRole:
+        if (row.section) return int(Qt::AlignCenter);
+        return index.column() == Team1Column ? int(Qt::AlignRight | Qt::AlignVCenter)
+                                             : int(Qt::AlignLeft | Qt::AlignVCenter);
+    case Qt::FontRole:
+        if (row.section) {
+            QFont font;
+            font.setBold(true);
+            font.setPointSize(12);
+            return font;
+        }
+        break;
+    case SectionRole:
+        return row.section;
+    }
+    return QVariant();
+}
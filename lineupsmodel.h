@@ -0,0 +1,50 @@
+#ifndef LINEUPSMODEL_H
+#define LINEUPSMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractTableModel>
+
+// Составы двух команд бок о бок: строка-заголовок «Основной состав», стартовые
+// игроки, затем заголовок «Запасной состав» и запасные. Заголовки разделов
+// занимают обе колонки (span задаёт представление по SectionRole).
+class LineupsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        Team1Column,
+        Team2Column,
+        ColumnCount
+    };
+
+    enum Role {
+        SectionRole = Qt::UserRole + 1     // строка — заголовок раздела
+    };
+
+    explicit LineupsModel(QObject *parent = nullptr);
+
+    void setLineups(const MatchHeader &header, const QVector<LineupEntry> &lineups);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    struct Row
+    {
+        bool section = false;
+        QString team1;      // у заголовка раздела — его название
+        QString team2;
+    };
+
+    void appendSection(const QString &title,
+                       const QVector<const LineupEntry *> &team1Players,
+                       const QVector<const LineupEntry *> &team2Players);
+
+    QVector<Row> rows;
+};
+
+#endif // LINEUPSMODEL_H
@@ -0,0 +1,430 @@
+#include "liveingestor.h"
+#include "standingsengine.h"
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QSet>
+#include <QDebug>
+
+namespace {
+
+// Сколько отклонённых строк выводить; остальные только считаются
+const quint64 MaxReportedErrors = 10;
+
+// Как часто проверять дописанные в файл строки в режиме follow
+const int FilePollMs = 50;
+
+int jsonId(const QJsonObject &object, const char *key)
+{
+    const QJsonValue value = object.value(QLatin1String(key));
+    return value.isDouble() ? value.toInt(-1) : -1;
+}
+
+} // namespace
+
+LiveIngestor::LiveIngestor(const QSqlDatabase &db, QObject *parent)
+    : QObject(parent),
+      db(db),
+      statements(db),
+      server(nullptr),
+      followFile(false),
+      maxRows(2000),
+      maxDelayMs(100)
+{
+    flushTimer.setSingleShot(true);
+    connect(&flushTimer, &QTimer::timeout, this, [this]() { flush(); });
+
+    filePoll.setInterval(FilePollMs);
+    connect(&filePoll, &QTimer::timeout, this, &LiveIngestor::readFileChunk);
+}
+
+LiveIngestor::~LiveIngestor()
+{
+    qDeleteAll(engines);
+}
+
+void LiveIngestor::setBatchLimits(int rows, int delayMs)
+{
+    maxRows = qMax(1, rows);
+    maxDelayMs = qMax(0, delayMs);
+}
+
+bool LiveIngestor::listen(const QString &socketName)
+{
+    server = new QLocalServer(this);
+    // Сокет мог остаться от аварийно завершённого прошлого запуска
+    QLocalServer::removeServer(socketName);
+    if (!server->listen(socketName)) {
+        qDebug() << "Не удалось открыть сокет" << socketName << ":" << server->errorString();
+        return false;
+    }
+
+    connect(server, &QLocalServer::newConnection, this, &LiveIngestor::onNewConnection);
+    return true;
+}
+
+void LiveIngestor::onNewConnection()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+            while (socket->canReadLine()) {
+                enqueue(socket->readLine());
+            }
+        });
+    }
+}
+
+bool LiveIngestor::readFile(const QString &path, bool follow)
+{
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Не удалось открыть" << path << ":" << file.errorString();
+        return false;
+    }
+
+    followFile = follow;
+    // Чтение идёт из цикла событий, чтобы партии записывались по тем же таймерам
+    QTimer::singleShot(0, this, &LiveIngestor::readFileChunk);
+    if (followFile) {
+        filePoll.start();
+    }
+    return true;
+}
+
+void LiveIngestor::readFileChunk()
+{
+    // Читаем порциями, чтобы большой файл не задерживал таймер записи партий
+    const qint64 chunkSize = 1 << 20;
+    QByteArray chunk = file.read(chunkSize);
+    fileBuffer.append(chunk);
+
+    int start = 0;
+    int end;
+    while ((end = fileBuffer.indexOf('\n', start)) >= 0) {
+        enqueue(fileBuffer.mid(start, end - start));
+        start = end + 1;
+    }
+    // Недописанная строка остаётся в буфере до следующего чтения
+    fileBuffer.remove(0, start);
+
+    if (chunk.size() == chunkSize) {
+        QTimer::singleShot(0, this, &LiveIngestor::readFileChunk);
+    } else if (!followFile) {
+        if (!fileBuffer.trimmed().isEmpty()) {
+            enqueue(fileBuffer);
+        }
+        fileBuffer.clear();
+        flush();
+        emit finished();
+    }
+}
+
+void LiveIngestor::enqueue(const QByteArray &line)
+{
+    if (line.trimmed().isEmpty()) return;
+
+    Delta delta;
+    if (!parse(line, &delta)) {
+        if (counters.rejected < MaxReportedErrors) {
+            qDebug() << "Строка пропущена:" << line.trimmed().left(200);
+        }
+        ++counters.rejected;
+        return;
+    }
+
+    if (pending.isEmpty()) {
+        batchAge.start();
+        flushTimer.start(maxDelayMs);
+    }
+    pending.append(delta);
+
+    if (pending.size() >= maxRows) {
+        flush();
+    }
+}
+
+bool LiveIngestor::parse(const QByteArray &line, Delta *delta)
+{
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(line, &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        return false;
+    }
+
+    const QJsonObject object = document.object();
+    const QString type = object.value("type").toString();
+    delta->matchId = jsonId(object, "match_id");
+    delta->teamId = jsonId(object, "team_id");
+    if (delta->matchId < 0) return false;
+
+    if (type == "event") {
+        delta->type = EventDelta;
+        delta->eventType = object.value("event_type").toString();
+        delta->minute = object.value("minute").toInt();
+        delta->playerId = jsonId(object, "player_id");
+        delta->relatedPlayerId = jsonId(object, "related_player_id");
+        delta->text = object.value("description").toString();
+        return !delta->eventType.isEmpty() && delta->teamId >= 0;
+    }
+    if (type == "score") {
+        delta->type = ScoreDelta;
+        delta->text = object.value("score").toString();
+        delta->status = object.value("status").toString();
+        return MatchResult::parse(delta->text).isValid();
+    }
+    if (type == "status") {
+        delta->type = StatusDelta;
+        delta->status = object.value("status").toString();
+        return !delta->status.isEmpty();
+    }
+    if (type == "stat") {
+        delta->type = StatDelta;
+        delta->name = object.value("name").toString();
+        const QJsonValue value = object.value("value");
+        delta->text = value.isDouble() ? QString::number(value.toDouble()) : value.toString();
+        return !delta->name.isEmpty() && delta->teamId >= 0;
+    }
+    return false;
+}
+
+LiveIngestor::LiveMatch *LiveIngestor::liveMatch(int matchId)
+{
+    auto it = matches.find(matchId);
+    if (it != matches.end()) return &it.value();
+
+    StatementCache::Run query(statements,
+        "SELECT tournament_id, team1_id, team2_id, home_goals, away_goals, match_status "
+        "FROM matches WHERE id = ?");
+    query.bind(0, matchId);
+    if (!query.exec() || !query.next()) {
+        return nullptr;
+    }
+
+    LiveMatch match;
+    match.tournamentId = query.value(0).toInt();
+    match.team1Id = query.value(1).toInt();
+    match.team2Id = query.value(2).toInt();
+    match.stored = MatchResult::fromColumns(query.value(3), query.value(4));
+    match.storedStatus = query.value(5).toString();
+    match.result = match.stored;
+    match.status = match.storedStatus;
+    return &matches.insert(matchId, match).value();
+}
+
+StandingsEngine *LiveIngestor::engine(int tournamentId)
+{
+    StandingsEngine *standings = engines.value(tournamentId);
+    if (!standings) {
+        standings = new StandingsEngine;
+        if (!standings->load(db, tournamentId)) {
+            delete standings;
+            return nullptr;
+        }
+        engines.insert(tournamentId, standings);
+    }
+    return standings;
+}
+
+bool LiveIngestor::apply(const Delta &delta)
+{
+    LiveMatch *match = liveMatch(delta.matchId);
+    if (!match) {
+        if (counters.rejected < MaxReportedErrors) {
+            qDebug() << "Матч" << delta.matchId << "не найден";
+        }
+        return false;
+    }
+
+    switch (delta.type) {
+    case EventDelta: {
+        StatementCache::Run insert(statements,
+            "INSERT INTO match_events (match_id, event_type, minute, team_id, player_id, "
+            "related_player_id, description) VALUES (?, ?, ?, ?, ?, ?, ?)");
+        insert.bind(0, delta.matchId);
+        insert.bind(1, delta.eventType);
+        insert.bind(2, delta.minute);
+        insert.bind(3, delta.teamId);
+        insert.bind(4, delta.playerId >= 0 ? QVariant(delta.playerId) : QVariant());
+        insert.bind(5, delta.relatedPlayerId >= 0 ? QVariant(delta.relatedPlayerId) : QVariant());
+        insert.bind(6, delta.text.isEmpty() ? QVariant() : QVariant(delta.text));
+        if (!insert.exec()) {
+            qDebug() << "Ошибка записи события:" << insert.lastError().text();
+            return false;
+        }
+
+        if (delta.eventType == "goal") {
+            if (!match->result.isValid()) {
+                match->result.homeGoals = 0;
+                match->result.awayGoals = 0;
+            }
+            if (delta.teamId == match->team1Id) {
+                ++match->result.homeGoals;
+            } else {
+                ++match->result.awayGoals;
+            }
+            match->dirty = true;
+        }
+        return true;
+    }
+    case ScoreDelta:
+        match->result = MatchResult::parse(delta.text);
+        if (!delta.status.isEmpty()) match->status = delta.status;
+        match->dirty = true;
+        return true;
+    case StatusDelta:
+        match->status = delta.status;
+        match->dirty = true;
+        return true;
+    case StatDelta:
+        pendingStats[qMakePair(delta.matchId, delta.teamId)].insert(delta.name, delta.text);
+        return true;
+    }
+    return false;
+}
+
+// Незавершённые матчи в таблице не учитываются, и их голы таблицу не трогают
+bool LiveIngestor::affectsStandings(const LiveMatch &match)
+{
+    return StandingsEngine::countsForStandings(match.stored, match.storedStatus)
+        || StandingsEngine::countsForStandings(match.result, match.status);
+}
+
+bool LiveIngestor::writeMatches()
+{
+    // Таблицы турниров собираются до обновления матчей: иначе load() уже увидел бы
+    // новые счета, и applyResult учёл бы их второй раз
+    for (auto it = matches.cbegin(); it != matches.cend(); ++it) {
+        const LiveMatch &match = it.value();
+        if (match.dirty && affectsStandings(match) && !engine(match.tournamentId)) return false;
+    }
+
+    QSet<StandingsEngine *> touched;
+
+    for (auto it = matches.begin(); it != matches.end(); ++it) {
+        LiveMatch &match = it.value();
+        if (!match.dirty) continue;
+
+        // Сколько бы событий матча ни пришло в партии, строка matches пишется один раз;
+        // home_goals и away_goals обновляет триггер по тексту счёта
+        StatementCache::Run update(statements,
+            "UPDATE matches SET score = ?, match_status = ? WHERE id = ?");
+        update.bind(0, match.result.isValid() ? QVariant(match.result.toString()) : QVariant());
+        update.bind(1, match.status.isEmpty() ? QVariant() : QVariant(match.status));
+        update.bind(2, it.key());
+        if (!update.exec()) {
+            qDebug() << "Ошибка записи счёта матча" << it.key() << ":" << update.lastError().text();
+            return false;
+        }
+
+        if (affectsStandings(match)) {
+            const bool countedBefore = StandingsEngine::countsForStandings(match.stored, match.storedStatus);
+            const bool countsNow = StandingsEngine::countsForStandings(match.result, match.status);
+            StandingsEngine *standings = engines.value(match.tournamentId);
+            standings->applyResult(match.team1Id, match.team2Id,
+                                   countedBefore ? match.stored : MatchResult(),
+                                   countsNow ? match.result : MatchResult());
+            touched.insert(standings);
+        }
+    }
+
+    for (StandingsEngine *standings : touched) {
+        if (!standings->writeChanges(db)) return false;
+    }
+    return true;
+}
+
+bool LiveIngestor::writeStats()
+{
+    for (auto it = pendingStats.cbegin(); it != pendingStats.cend(); ++it) {
+        for (auto stat = it.value().cbegin(); stat != it.value().cend(); ++stat) {
+            StatementCache::Run upsert(statements,
+                "INSERT INTO match_stats (match_id, team_id, stat_name, stat_value) VALUES (?, ?, ?, ?) "
+                "ON CONFLICT (match_id, team_id, stat_name) DO UPDATE SET stat_value = excluded.stat_value");
+            upsert.bind(0, it.key().first);
+            upsert.bind(1, it.key().second);
+            upsert.bind(2, stat.key());
+            upsert.bind(3, stat.value());
+            if (!upsert.exec()) {
+                qDebug() << "Ошибка записи статистики матча" << it.key().first << ":"
+                         << upsert.lastError().text();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool LiveIngestor::flush()
+{
+    flushTimer.stop();
+    if (pending.isEmpty()) return true;
+
+    QElapsedTimer writeTimer;
+    writeTimer.start();
+
+    const QVector<Delta> batch = std::move(pending);
+    pending.clear();
+
+    if (!db.transaction()) {
+        qDebug() << "Не удалось начать транзакцию:" << db.lastError().text();
+        counters.rejected += batch.size();
+        ++counters.failedBatches;
+        return false;
+    }
+
+    quint64 accepted = 0;
+    for (const Delta &delta : batch) {
+        if (apply(delta)) {
+            ++accepted;
+        } else {
+            ++counters.rejected;
+        }
+    }
+
+    // Счёт, таблица и статистика всей партии фиксируются одной транзакцией
+    if (!writeStats() || !writeMatches() || !db.commit()) {
+        qDebug() << "Партия из" << batch.size() << "строк не записана:" << db.lastError().text();
+        db.rollback();
+        // Кешированные счета и таблицы могли разойтись с БД: перечитываем их заново
+        resetState();
+        counters.rejected += accepted;
+        ++counters.failedBatches;
+        return false;
+    }
+
+    for (auto it = matches.begin(); it != matches.end();) {
+        LiveMatch &match = it.value();
+        if (!match.dirty) {
+            ++it;
+            continue;
+        }
+        // Завершённый матч больше не обновляется; поздняя поправка перечитает его из БД
+        if (match.status == "finished") {
+            it = matches.erase(it);
+            continue;
+        }
+        match.stored = match.result;
+        match.storedStatus = match.status;
+        match.dirty = false;
+        ++it;
+    }
+    pendingStats.clear();
+
+    counters.accepted += accepted;
+    ++counters.batches;
+    counters.writeMs += writeTimer.elapsed();
+    counters.maxLatencyMs = qMax(counters.maxLatencyMs, batchAge.elapsed());
+    return true;
+}
+
+void LiveIngestor::resetState()
+{
+    matches.clear();
+    pendingStats.clear();
+    qDeleteAll(engines);
+    engines.clear();
+}
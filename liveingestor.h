@@ -0,0 +1,133 @@
+#ifndef LIVEINGESTOR_H
+#define LIVEINGESTOR_H
+
+#include "datatypes.h"
+#include "statementcache.h"
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QHash>
+#include <QFile>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class QLocalServer;
+class StandingsEngine;
+
+// Приём живых событий матчей: строки NDJSON из локального сокета или файла
+// копятся в очереди и записываются микропартиями — одна транзакция WAL на
+// партию. Партия записывается, когда набралось maxRows изменений или прошло
+// maxDelayMs с первого из них, поэтому задержка ограничена при любом потоке.
+//
+// Форматы строк:
+//   {"type":"event","match_id":1,"event_type":"goal","minute":12,"team_id":3,
+//    "player_id":7,"related_player_id":8,"description":"..."}
+//   {"type":"score","match_id":1,"score":"2-1","status":"live"}
+//   {"type":"status","match_id":1,"status":"finished"}
+//   {"type":"stat","match_id":1,"team_id":3,"name":"Удары","value":"7"}
+//
+// Гол увеличивает счёт забившей команды, "score" задаёт счёт явно (поправка).
+// Счёт, статус и статистика матча сворачиваются до последнего значения в
+// партии, а турнирная таблица пересчитывается инкрементально и пишется в той
+// же транзакции. Состояние матчей кешируется: сервис считается единственным
+// писателем живых матчей.
+class LiveIngestor : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats
+    {
+        quint64 accepted = 0;
+        quint64 rejected = 0;
+        quint64 batches = 0;
+        quint64 failedBatches = 0;
+        qint64 maxLatencyMs = 0;    // от прихода первой строки партии до фиксации
+        qint64 writeMs = 0;         // суммарное время транзакций
+    };
+
+    explicit LiveIngestor(const QSqlDatabase &db, QObject *parent = nullptr);
+    ~LiveIngestor();
+
+    void setBatchLimits(int rows, int delayMs);
+
+    bool listen(const QString &socketName);
+    // follow: продолжать читать дописываемые в файл строки, как tail -f
+    bool readFile(const QString &path, bool follow);
+
+    void enqueue(const QByteArray &line);
+    bool flush();
+
+    const Stats &stats() const { return counters; }
+
+signals:
+    // Файл без follow прочитан до конца и записан
+    void finished();
+
+private:
+    enum DeltaType {
+        EventDelta,
+        ScoreDelta,
+        StatusDelta,
+        StatDelta
+    };
+
+    struct Delta
+    {
+        DeltaType type = EventDelta;
+        int matchId = -1;
+        int teamId = -1;
+        int minute = 0;
+        int playerId = -1;
+        int relatedPlayerId = -1;
+        QString eventType;
+        QString text;           // описание события, счёт или значение статистики
+        QString name;           // название статистики
+        QString status;
+    };
+
+    struct LiveMatch
+    {
+        int tournamentId = -1;
+        int team1Id = -1;
+        int team2Id = -1;
+        MatchResult stored;     // как записано в БД и учтено в таблице
+        QString storedStatus;
+        MatchResult result;
+        QString status;
+        bool dirty = false;
+    };
+
+    static bool parse(const QByteArray &line, Delta *delta);
+
+    void onNewConnection();
+    void readFileChunk();
+    LiveMatch *liveMatch(int matchId);
+    StandingsEngine *engine(int tournamentId);
+    bool apply(const Delta &delta);
+    static bool affectsStandings(const LiveMatch &match);
+    bool writeMatches();
+    bool writeStats();
+    void resetState();
+
+    QSqlDatabase db;
+    StatementCache statements;
+    QLocalServer *server;
+    QFile file;
+    QByteArray fileBuffer;
+    bool followFile;
+    QTimer filePoll;
+
+    int maxRows;
+    int maxDelayMs;
+    QTimer flushTimer;
+    QElapsedTimer batchAge;         // с прихода первой строки текущей партии
+
+    QVector<Delta> pending;
+    QHash<int, LiveMatch> matches;
+    QHash<int, StandingsEngine *> engines;
+    QHash<QPair<int, int>, QHash<QString, QString>> pendingStats;  // (матч, команда) -> показатель -> значение
+    Stats counters;
+};
+
+#endif // LIVEINGESTOR_H
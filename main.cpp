@@ -1,10 +1,12 @@
 #include "sportstracker.h"
+#include "apptheme.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    AppTheme::apply(a);
     SportsTracker w;
     w.show();
     return a.exec();
@@ -0,0 +1,77 @@
+#include "matchdetailscache.h"
+#include <QDebug>
+
+namespace {
+
+int stringCost(const QString &value)
+{
+    // Интернированные имена из справочника разделяют буфер, поэтому это оценка сверху
+    return int(sizeof(QString)) + value.size() * int(sizeof(QChar));
+}
+
+int historyCost(const QVector<HistoryRow> &rows)
+{
+    int cost = 0;
+    for (const HistoryRow &row : rows) {
+        cost += int(sizeof(HistoryRow)) + stringCost(row.date) + stringCost(row.team1)
+              + stringCost(row.team2) + stringCost(row.score);
+    }
+    return cost;
+}
+
+} // namespace
+
+MatchDetailsCache::MatchDetailsCache()
+{
+    int budgetKb = DefaultBudgetKb;
+    if (qEnvironmentVariableIsSet("SPORTSTRACKER_DETAILS_CACHE_KB")) {
+        bool ok = false;
+        int value = qEnvironmentVariableIntValue("SPORTSTRACKER_DETAILS_CACHE_KB", &ok);
+        if (ok && value >= 0) {
+            budgetKb = value;
+        } else {
+            qDebug() << "Некорректный размер кэша матчей, используется" << DefaultBudgetKb << "КБ";
+        }
+    }
+    setBudget(budgetKb * 1024);
+}
+
+void MatchDetailsCache::setBudget(int bytes)
+{
+    cache.setMaxCost(bytes);
+}
+
+const MatchDetails *MatchDetailsCache::find(int matchId)
+{
+    return cache.object(matchId);
+}
+
+void MatchDetailsCache::insert(const MatchDetails &details)
+{
+    // Запись больше всего бюджета QCache не примет и удалит сам
+    cache.insert(details.header.id, new MatchDetails(details), estimateCost(details));
+}
+
+int MatchDetailsCache::estimateCost(const MatchDetails &details)
+{
+    int cost = int(sizeof(MatchDetails)) + stringCost(details.header.team1)
+             + stringCost(details.header.team2);
+
+    for (const StatRow &row : details.stats) {
+        cost += int(sizeof(StatRow)) + stringCost(row.name)
+              + stringCost(row.team1Value) + stringCost(row.team2Value);
+    }
+    for (const LineupEntry &entry : details.lineups) {
+        cost += int(sizeof(LineupEntry)) + stringCost(entry.jersey) + stringCost(entry.name)
+              + stringCost(entry.position);
+    }
+    for (const EventRow &event : details.events) {
+        cost += int(sizeof(EventRow)) + stringCost(event.type) + stringCost(event.player)
+              + stringCost(event.description);
+    }
+
+    cost += historyCost(details.team1Recent);
+    cost += historyCost(details.team2Recent);
+    cost += historyCost(details.headToHead);
+    return cost;
+}
@@ -0,0 +1,36 @@
+#ifndef MATCHDETAILSCACHE_H
+#define MATCHDETAILSCACHE_H
+
+#include "datatypes.h"
+
+#include <QCache>
+
+// Кэш уже загруженных страниц матча с вытеснением давно не открывавшихся (LRU).
+// Объём ограничен бюджетом в байтах; стоимость записи оценивается по размеру
+// строк и векторов, из которых она состоит. Используется только в GUI-потоке.
+class MatchDetailsCache
+{
+public:
+    // Бюджет по умолчанию; переопределяется переменной SPORTSTRACKER_DETAILS_CACHE_KB
+    static const int DefaultBudgetKb = 4096;
+
+    MatchDetailsCache();
+
+    void setBudget(int bytes);
+    int budget() const { return cache.maxCost(); }
+    int usedBytes() const { return cache.totalCost(); }
+    int count() const { return cache.count(); }
+
+    bool contains(int matchId) const { return cache.contains(matchId); }
+    // Возвращает nullptr, если матча нет; найденная запись становится самой свежей
+    const MatchDetails *find(int matchId);
+    void insert(const MatchDetails &details);
+    void clear() { cache.clear(); }
+
+    static int estimateCost(const MatchDetails &details);
+
+private:
+    QCache<int, MatchDetails> cache;
+};
+
+#endif // MATCHDETAILSCACHE_H
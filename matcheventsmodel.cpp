@@ -0,0 +1,85 @@
+#include "matcheventsmodel.h"
+
+MatchEventsModel::MatchEventsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void MatchEventsModel::setEvents(const MatchHeader &newHeader, const QVector<EventRow> &newEvents)
+{
+    beginResetModel();
+    header = newHeader;
+    events = newEvents;
+    endResetModel();
+}
+
+void MatchEventsModel::updateEvents(const QVector<EventRow> &newEvents)
+{
+    if (newEvents.size() < events.size()) {
+        beginRemoveRows(QModelIndex(), newEvents.size(), events.size() - 1);
+        events.resize(newEvents.size());
+        endRemoveRows();
+    }
+
+    for (int i = 0; i < events.size(); ++i) {
+        if (events[i] == newEvents[i]) continue;
+        events[i] = newEvents[i];
+        emit dataChanged(index(i, 0), index(i, columnCount() - 1));
+    }
+
+    if (newEvents.size() > events.size()) {
+        beginInsertRows(QModelIndex(), events.size(), newEvents.size() - 1);
+        events += newEvents.mid(events.size());
+        endInsertRows();
+    }
+}
+
+void MatchEventsModel::clear()
+{
+    setEvents(MatchHeader(), QVector<EventRow>());
+}
+
+int MatchEventsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : events.size();
+}
+
+int MatchEventsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 5;
+}
+
+QVariant MatchEventsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= events.size() || role != Qt::DisplayRole) return QVariant();
+
+    const EventRow &event = events.at(index.row());
+    switch (index.column()) {
+    case 0: return eventTypeName(event.type);
+    case 1: return event.minute;
+    case 2: return event.player.isEmpty() ? QString("-") : event.player;
+    case 3: return event.description;
+    case 4: return event.teamId == header.team1Id ? header.team1 : header.team2;
+    }
+    return QVariant();
+}
+
+QVariant MatchEventsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    static const char *headers[] = {"Тип", "Минута", "Игрок", "Описание", "Команда"};
+    if (section < 0 || section >= 5) return QVariant();
+    return QString::fromUtf8(headers[section]);
+}
+
+QString MatchEventsModel::eventTypeName(const QString &type)
+{
+    if (type == "goal") return "Гол";
+    if (type == "yellow_card") return "ЖК";
+    if (type == "red_card") return "КК";
+    if (type == "substitution") return "Замена";
+    return type;
+}
@@ -0,0 +1,33 @@
+#ifndef MATCHEVENTSMODEL_H
+#define MATCHEVENTSMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractTableModel>
+
+// Ход матча: голы, карточки и замены в порядке минут.
+class MatchEventsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit MatchEventsModel(QObject *parent = nullptr);
+
+    void setEvents(const MatchHeader &header, const QVector<EventRow> &events);
+    // События того же матча: изменённые строки обновляются, новые добавляются в конец
+    void updateEvents(const QVector<EventRow> &events);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    static QString eventTypeName(const QString &type);
+
+private:
+    MatchHeader header;
+    QVector<EventRow> events;
+};
+
+#endif // MATCHEVENTSMODEL_H
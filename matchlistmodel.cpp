@@ -0,0 +1,102 @@
+#include "matchlistmodel.h"
+
+MatchListModel::MatchListModel(QObject *parent)
+    : QAbstractListModel(parent),
+      exhausted(true),
+      fetching(false)
+{
+}
+
+void MatchListModel::reset()
+{
+    beginResetModel();
+    rows.clear();
+    rows.squeeze();
+    exhausted = false;
+    fetching = false;
+    endResetModel();
+}
+
+void MatchListModel::clear()
+{
+    // В отличие от reset() не разрешает подгрузку, пока не выбран источник
+    reset();
+    exhausted = true;
+}
+
+void MatchListModel::appendPage(const QVector<MatchListRow> &page, bool last)
+{
+    fetching = false;
+    exhausted = last;
+    if (page.isEmpty()) return;
+
+    beginInsertRows(QModelIndex(), rows.size(), rows.size() + page.size() - 1);
+    rows += page;
+    endInsertRows();
+}
+
+bool MatchListModel::updateFirstPage(const QVector<MatchListRow> &page, bool last)
+{
+    bool sameMatches = last ? page.size() == rows.size() : page.size() <= rows.size();
+    for (int i = 0; sameMatches && i < page.size(); ++i) {
+        sameMatches = rows[i].id == page[i].id;
+    }
+    if (!sameMatches) return false;
+
+    for (int i = 0; i < page.size(); ++i) {
+        if (rows[i] == page[i]) continue;
+        rows[i] = page[i];
+        emit dataChanged(index(i), index(i));
+    }
+    return true;
+}
+
+bool MatchListModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !exhausted && !fetching;
+}
+
+void MatchListModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) return;
+
+    fetching = true;
+    MatchPageCursor after;
+    if (!rows.isEmpty()) {
+        after.date = rows.last().date;
+        after.id = rows.last().id;
+    }
+    emit fetchMoreRequested(after);
+}
+
+int MatchListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+QVariant MatchListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+
+    const MatchListRow &row = rows.at(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return displayText(row);
+    case Qt::UserRole:
+        return row.id;
+    }
+    return QVariant();
+}
+
+QString MatchListModel::displayText(const MatchListRow &row)
+{
+    QString score = row.score;
+    if (score == "-") score = "? - ?";
+
+    return QString("%1: %2 %3 %4")
+        .arg(QDate::fromString(row.date.left(10), Qt::ISODate).toString("dd.MM.yyyy"))
+        .arg(row.team1)
+        .arg(score)
+        .arg(row.team2);
+}
@@ -0,0 +1,44 @@
+#ifndef MATCHLISTMODEL_H
+#define MATCHLISTMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractListModel>
+
+// Список матчей тура или всего турнира. Строки подгружаются страницами
+// по мере прокрутки: fetchMore() запрашивает следующую страницу после
+// последней загруженной пары (date, id), а appendPage() добавляет её в конец.
+// Текст строки формируется при отрисовке, id матча доступен через Qt::UserRole.
+class MatchListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit MatchListModel(QObject *parent = nullptr);
+
+    void reset();
+    void clear();
+    void appendPage(const QVector<MatchListRow> &page, bool last);
+    // Свежая первая страница того же списка: изменённые строки обновляются на
+    // месте. Если матчи добавились или пропали, модель не меняется и возвращается
+    // false: список нужно показать заново, отменив загрузку следующих страниц
+    bool updateFirstPage(const QVector<MatchListRow> &page, bool last);
+    const MatchListRow &rowAt(int row) const { return rows.at(row); }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    static QString displayText(const MatchListRow &row);
+
+signals:
+    void fetchMoreRequested(const MatchPageCursor &after);
+
+private:
+    QVector<MatchListRow> rows;
+    bool exhausted;
+    bool fetching;
+};
+
+#endif // MATCHLISTMODEL_H
@@ -0,0 +1,116 @@
+#include "matchstatsmodel.h"
+#include "statcatalogue.h"
+#include <QFont>
+
+MatchStatsModel::MatchStatsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void MatchStatsModel::setStats(const MatchHeader &header, const QVector<StatRow> &stats)
+{
+    beginResetModel();
+    team1 = header.team1;
+    team2 = header.team2;
+    rows = stats;
+    endResetModel();
+}
+
+void MatchStatsModel::updateStats(const QVector<StatRow> &stats)
+{
+    if (stats.size() != rows.size()) {
+        beginResetModel();
+        rows = stats;
+        endResetModel();
+        return;
+    }
+
+    for (int i = 0; i < rows.size(); ++i) {
+        if (rows[i] == stats[i]) continue;
+        rows[i] = stats[i];
+        // Строка 0 занята названиями команд
+        emit dataChanged(index(i + 1, 0), index(i + 1, ColumnCount - 1));
+    }
+}
+
+void MatchStatsModel::clear()
+{
+    setStats(MatchHeader(), QVector<StatRow>());
+}
+
+int MatchStatsModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || team1.isEmpty()) return 0;
+    return rows.size() + 1;
+}
+
+int MatchStatsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant MatchStatsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() > rows.size()) return QVariant();
+
+    const bool headerRow = index.row() == 0;
+    if (role == HeaderRowRole) return headerRow;
+
+    if (headerRow) {
+        switch (role) {
+        case Qt::DisplayRole:
+            if (index.column() == Team1Column) return team1;
+            if (index.column() == Team2Column) return team2;
+            return QVariant();
+        case Qt::FontRole: {
+            QFont font;
+            font.setBold(true);
+            font.setPointSize(12);
+            return font;
+        }
+        case Qt::TextAlignmentRole:
+            return index.column() == Team1Column ? int(Qt::AlignRight | Qt::AlignVCenter)
+                                                 : int(Qt::AlignLeft | Qt::AlignVCenter);
+        }
+        return QVariant();
+    }
+
+    const StatRow &row = rows.at(index.row() - 1);
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case Team1Column: return row.team1Value;
+        case NameColumn: return row.name;
+        case Team2Column: return row.team2Value;
+        }
+        break;
+    case Qt::FontRole:
+        if (index.column() == NameColumn) {
+            QFont font;
+            font.setBold(true);
+            font.setPointSize(12);
+            return font;
+        }
+        break;
+    case Qt::TextAlignmentRole:
+        switch (index.column()) {
+        case Team1Column: return int(Qt::AlignRight | Qt::AlignVCenter);
+        case NameColumn: return int(Qt::AlignCenter);
+        case Team2Column: return int(Qt::AlignLeft | Qt::AlignVCenter);
+        }
+        break;
+    case ShareRole: {
+        if (index.column() == NameColumn) break;
+        double value1 = 0;
+        double value2 = 0;
+        if (!StatCatalogue::parse(row.team1Value, &value1) || !StatCatalogue::parse(row.team2Value, &value2)
+            || value1 < 0 || value2 < 0) {
+            break;
+        }
+        const double total = value1 + value2;
+        if (total <= 0) return 0.0;
+        return (index.column() == Team1Column ? value1 : value2) / total;
+    }
+    }
+    return QVariant();
+}
@@ -0,0 +1,46 @@
+#ifndef MATCHSTATSMODEL_H
+#define MATCHSTATSMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractTableModel>
+
+// Основная статистика матча: первая строка — названия команд, далее
+// показатель посередине и значения команд по краям. Доля каждой команды
+// в сумме числового показателя отдаётся делегату для полосы сравнения.
+class MatchStatsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        Team1Column,
+        NameColumn,
+        Team2Column,
+        ColumnCount
+    };
+
+    enum Role {
+        ShareRole = Qt::UserRole + 1,   // доля команды от 0 до 1; нет у нечисловых показателей
+        HeaderRowRole                   // строка с названиями команд
+    };
+
+    explicit MatchStatsModel(QObject *parent = nullptr);
+
+    void setStats(const MatchHeader &header, const QVector<StatRow> &stats);
+    // Статистика того же матча: перерисовываются только изменившиеся строки
+    void updateStats(const QVector<StatRow> &stats);
+    void clear();
+    const QVector<StatRow> &stats() const { return rows; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    QString team1;
+    QString team2;
+    QVector<StatRow> rows;
+};
+
+#endif // MATCHSTATSMODEL_H
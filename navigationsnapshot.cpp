@@ -0,0 +1,162 @@
+#include "navigationsnapshot.h"
+#include <QDataStream>
+#include <QSaveFile>
+#include <QFile>
+#include <QDebug>
+
+namespace {
+
+const quint32 SnapshotMagic = 0x53544e56;      // "STNV"
+const quint16 SnapshotVersion = 2;      // 2: зона строки таблицы
+
+} // namespace
+
+// Операторы объявлены в глобальном пространстве имён, чтобы их находили
+// шаблонные операторы QVector<T> через поиск по аргументам
+static QDataStream &operator<<(QDataStream &out, const SportRow &row)
+{
+    return out << qint32(row.id) << row.name;
+}
+
+static QDataStream &operator>>(QDataStream &in, SportRow &row)
+{
+    qint32 id;
+    in >> id >> row.name;
+    row.id = id;
+    return in;
+}
+
+static QDataStream &operator<<(QDataStream &out, const TournamentRow &row)
+{
+    return out << qint32(row.id) << qint32(row.sportId) << row.name;
+}
+
+static QDataStream &operator>>(QDataStream &in, TournamentRow &row)
+{
+    qint32 id, sportId;
+    in >> id >> sportId >> row.name;
+    row.id = id;
+    row.sportId = sportId;
+    return in;
+}
+
+static QDataStream &operator<<(QDataStream &out, const RoundInfo &row)
+{
+    return out << qint32(row.round) << qint32(row.matchCount) << qint32(row.finishedCount)
+               << row.firstDate << row.lastDate;
+}
+
+static QDataStream &operator>>(QDataStream &in, RoundInfo &row)
+{
+    qint32 round, matchCount, finishedCount;
+    in >> round >> matchCount >> finishedCount >> row.firstDate >> row.lastDate;
+    row.round = round;
+    row.matchCount = matchCount;
+    row.finishedCount = finishedCount;
+    return in;
+}
+
+// Числовые столбцы таблицы пишутся подряд в порядке объявления
+static QDataStream &operator<<(QDataStream &out, const StandingRow &row)
+{
+    return out << qint32(row.position) << qint32(row.teamId) << row.team
+               << qint32(row.points) << qint32(row.played) << qint32(row.wins)
+               << qint32(row.draws) << qint32(row.losses)
+               << qint32(row.goalsFor) << qint32(row.goalsAgainst) << quint8(row.zone);
+}
+
+static QDataStream &operator>>(QDataStream &in, StandingRow &row)
+{
+    qint32 values[9];
+    quint8 zone;
+    in >> values[0] >> values[1] >> row.team;
+    for (int i = 2; i < 9; ++i) {
+        in >> values[i];
+    }
+    in >> zone;
+    row.position = values[0];
+    row.teamId = values[1];
+    row.points = values[2];
+    row.played = values[3];
+    row.wins = values[4];
+    row.draws = values[5];
+    row.losses = values[6];
+    row.goalsFor = values[7];
+    row.goalsAgainst = values[8];
+    row.zone = zone <= RelegationZone ? StandingZone(zone) : NoZone;
+    return in;
+}
+
+bool NavigationSnapshot::save(const QString &path) const
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Не удалось записать снимок навигации:" << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << SnapshotMagic << SnapshotVersion;
+    out << sports;
+    out << qint32(tournaments.size());
+    for (auto it = tournaments.constBegin(); it != tournaments.constEnd(); ++it) {
+        out << qint32(it.key()) << it.value();
+    }
+    out << expandedSports;
+    out << qint32(tournamentId) << tournamentName << qint32(round) << rounds << standings;
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qDebug() << "Не удалось записать снимок навигации:" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool NavigationSnapshot::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != SnapshotMagic || version != SnapshotVersion) {
+        qDebug() << "Снимок навигации другого формата, пропускаем:" << path;
+        return false;
+    }
+
+    // Разбираем во временный снимок, чтобы повреждённый файл не оставил половину данных
+    NavigationSnapshot loaded;
+    qint32 sportCount = 0;
+    in >> loaded.sports >> sportCount;
+    for (qint32 i = 0; i < sportCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 sportId;
+        QVector<TournamentRow> rows;
+        in >> sportId >> rows;
+        loaded.tournaments.insert(sportId, rows);
+    }
+    qint32 tournament, round;
+    in >> loaded.expandedSports >> tournament >> loaded.tournamentName >> round
+       >> loaded.rounds >> loaded.standings;
+    loaded.tournamentId = tournament;
+    loaded.round = round;
+
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "Снимок навигации повреждён:" << path;
+        return false;
+    }
+
+    *this = loaded;
+    return true;
+}
+
+QString NavigationSnapshot::pathFor(const QString &databasePath)
+{
+    return databasePath + ".snapshot";
+}
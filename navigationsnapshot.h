@@ -0,0 +1,35 @@
+#ifndef NAVIGATIONSNAPSHOT_H
+#define NAVIGATIONSNAPSHOT_H
+
+#include "datatypes.h"
+
+#include <QHash>
+
+// Состояние навигации, сохраняемое при выходе: дерево видов спорта с уже
+// раскрытыми турнирами и последний открытый турнир с его турами и таблицей.
+// При запуске окно строится из снимка сразу, а БД открывается в фоне;
+// пришедшие из неё данные заменяют показанные, только если отличаются.
+// Формат — QDataStream с сигнатурой и номером версии; снимок другой версии
+// или повреждённый файл просто не загружаются.
+struct NavigationSnapshot
+{
+    QVector<SportRow> sports;
+    QHash<int, QVector<TournamentRow>> tournaments;     // sport_id -> турниры раскрытых видов спорта
+    QList<int> expandedSports;
+
+    int tournamentId = -1;
+    QString tournamentName;
+    int round = -1;
+    QVector<RoundInfo> rounds;
+    QVector<StandingRow> standings;
+
+    bool isEmpty() const { return sports.isEmpty(); }
+
+    bool save(const QString &path) const;
+    bool load(const QString &path);
+
+    // Снимок хранится рядом с файлом БД, чтобы у каждой БД был свой
+    static QString pathFor(const QString &databasePath);
+};
+
+#endif // NAVIGATIONSNAPSHOT_H
@@ -0,0 +1,288 @@
+#include "reportgenerator.h"
+#include "connectionpool.h"
+#include "sportsrepository.h"
+#include "standingsengine.h"
+#include "teamdictionary.h"
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSaveFile>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+#include <atomic>
+
+namespace {
+
+QString csvField(const QString &value)
+{
+    if (!value.contains(',') && !value.contains('"') && !value.contains('\n')) {
+        return value;
+    }
+    QString escaped = value;
+    escaped.replace('"', "\"\"");
+    return '"' + escaped + '"';
+}
+
+QString renderCsv(const ReportTable &table)
+{
+    QString text;
+    QStringList fields;
+    for (const QString &header : table.headers) {
+        fields.append(csvField(header));
+    }
+    text += fields.join(',') + '\n';
+
+    for (const QStringList &row : table.rows) {
+        fields.clear();
+        for (const QString &value : row) {
+            fields.append(csvField(value));
+        }
+        text += fields.join(',') + '\n';
+    }
+    return text;
+}
+
+QString renderJson(const ReportTable &table)
+{
+    QJsonArray rows;
+    for (const QStringList &row : table.rows) {
+        QJsonObject object;
+        for (int i = 0; i < table.headers.size() && i < row.size(); ++i) {
+            object.insert(table.headers[i], row[i]);
+        }
+        rows.append(object);
+    }
+
+    QJsonObject root;
+    root.insert("title", table.title);
+    root.insert("rows", rows);
+    return QString::fromUtf8(QJsonDocument(root).toJson(QJsonDocument::Indented));
+}
+
+QString renderHtml(const ReportTable &table)
+{
+    QString html;
+    html += "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>"
+          + table.title.toHtmlEscaped() + "</title>\n"
+          "<style>body { font-family: sans-serif; } "
+          "table { border-collapse: collapse; } "
+          "th { background: #4a90e2; color: white; padding: 6px; } "
+          "td { border: 1px solid #ddd; padding: 4px 8px; text-align: center; }</style>"
+          "</head><body>\n";
+    html += "<h2>" + table.title.toHtmlEscaped() + "</h2>\n<table>\n<tr>";
+    for (const QString &header : table.headers) {
+        html += "<th>" + header.toHtmlEscaped() + "</th>";
+    }
+    html += "</tr>\n";
+    for (const QStringList &row : table.rows) {
+        html += "<tr>";
+        for (const QString &value : row) {
+            html += "<td>" + value.toHtmlEscaped() + "</td>";
+        }
+        html += "</tr>\n";
+    }
+    html += "</table>\n</body></html>\n";
+    return html;
+}
+
+} // namespace
+
+ReportGenerator::ReportGenerator(const QString &databasePath, int jobs)
+    : config(DatabaseConfig::fromEnvironment(databasePath)),
+      connectionName(QString("reports-%1").arg(reinterpret_cast<quintptr>(this))),
+      pool(new ConnectionPool(config, qMax(1, jobs))),
+      outputDirectory("."),
+      format(CsvFormat)
+{
+}
+
+ReportGenerator::~ReportGenerator()
+{
+    delete pool;
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+bool ReportGenerator::open()
+{
+    // Справочник и список турниров читаются один раз; соединение сразу закрывается
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    if (!config.open(db, DatabaseConfig::ReadOnly)) {
+        return false;
+    }
+
+    auto dictionary = std::make_shared<TeamDictionary>();
+    bool ok = dictionary->load(db);
+    if (ok) {
+        pool->setDictionary(dictionary);
+
+        SportsRepository repository(db);
+        for (const SportRow &sport : repository.sports()) {
+            for (const TournamentRow &tournament : repository.tournaments(sport.id)) {
+                tournamentNames.insert(tournament.id, tournament.name);
+            }
+        }
+    }
+
+    db.close();
+    return ok;
+}
+
+void ReportGenerator::setOutput(const QString &directory, Format newFormat)
+{
+    outputDirectory = directory;
+    format = newFormat;
+}
+
+void ReportGenerator::addStandings(int tournamentId)
+{
+    QString name = tournamentNames.value(tournamentId, QString::number(tournamentId));
+    jobs.append({QString("standings-%1").arg(tournamentId), [tournamentId, name](SportsRepository &repo) {
+        return standingsReport(repo, tournamentId, name);
+    }});
+}
+
+void ReportGenerator::addMatches(int tournamentId)
+{
+    QString name = tournamentNames.value(tournamentId, QString::number(tournamentId));
+    jobs.append({QString("matches-%1").arg(tournamentId), [tournamentId, name](SportsRepository &repo) {
+        return matchesReport(repo, tournamentId, name);
+    }});
+}
+
+void ReportGenerator::addHeadToHead(int team1Id, int team2Id)
+{
+    jobs.append({QString("h2h-%1-%2").arg(team1Id).arg(team2Id), [team1Id, team2Id](SportsRepository &repo) {
+        return headToHeadReport(repo, team1Id, team2Id);
+    }});
+}
+
+int ReportGenerator::run()
+{
+    if (!QDir().mkpath(outputDirectory)) {
+        qDebug() << "Не удалось создать каталог" << outputDirectory;
+        return jobs.size();
+    }
+
+    std::atomic<int> failed(0);
+    const QString suffix = extension(format);
+    const Format outputFormat = format;
+
+    for (const Job &job : jobs) {
+        QString path = QDir(outputDirectory).filePath(job.fileName + '.' + suffix);
+        pool->run([&failed, job, path, outputFormat](SportsRepository &repo) {
+            ReportTable table = job.build(repo);
+
+            // QSaveFile заменяет файл целиком только после успешной записи
+            QSaveFile file(path);
+            if (!file.open(QIODevice::WriteOnly)
+                || file.write(render(table, outputFormat).toUtf8()) < 0
+                || !file.commit()) {
+                qDebug() << "Не удалось записать отчёт" << path << ":" << file.errorString();
+                failed++;
+            }
+        });
+    }
+
+    // Задачи, для которых пул не смог открыть соединение, не выполняются вовсе
+    pool->waitForDone();
+    jobs.clear();
+    return failed.load();
+}
+
+bool ReportGenerator::parseFormat(const QString &name, Format *result)
+{
+    QString lower = name.toLower();
+    if (lower == "csv") {
+        *result = CsvFormat;
+    } else if (lower == "json") {
+        *result = JsonFormat;
+    } else if (lower == "html") {
+        *result = HtmlFormat;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+QString ReportGenerator::extension(Format format)
+{
+    switch (format) {
+    case CsvFormat: return "csv";
+    case JsonFormat: return "json";
+    case HtmlFormat: return "html";
+    }
+    return "txt";
+}
+
+QString ReportGenerator::render(const ReportTable &table, Format format)
+{
+    switch (format) {
+    case CsvFormat: return renderCsv(table);
+    case JsonFormat: return renderJson(table);
+    case HtmlFormat: return renderHtml(table);
+    }
+    return QString();
+}
+
+ReportTable ReportGenerator::standingsReport(SportsRepository &repo, int tournamentId, const QString &name)
+{
+    ReportTable table;
+    table.title = QString("Турнирная таблица: %1").arg(name);
+    table.headers = QStringList{"Поз", "Команда", "О", "И", "В", "Н", "П", "ЗГ", "ПГ", "РГ"};
+
+    QVector<StandingRow> rows = repo.standings(tournamentId);
+    if (rows.isEmpty()) {
+        // Сохранённой таблицы нет: считаем её по матчам, ничего не записывая
+        StandingsEngine engine;
+        if (engine.load(repo.database(), tournamentId)) {
+            rows = engine.rows();
+        }
+    }
+
+    for (const StandingRow &row : rows) {
+        table.rows.append({QString::number(row.position), row.team, QString::number(row.points),
+                           QString::number(row.played), QString::number(row.wins),
+                           QString::number(row.draws), QString::number(row.losses),
+                           QString::number(row.goalsFor), QString::number(row.goalsAgainst),
+                           QString::number(row.goalsFor - row.goalsAgainst)});
+    }
+    return table;
+}
+
+ReportTable ReportGenerator::matchesReport(SportsRepository &repo, int tournamentId, const QString &name)
+{
+    ReportTable table;
+    table.title = QString("Матчи: %1").arg(name);
+    table.headers = QStringList{"Дата", "Хозяева", "Гости", "Счёт"};
+
+    // Весь турнир читается теми же страницами, что и список матчей в приложении
+    const int pageSize = 500;
+    MatchPageCursor after;
+    for (;;) {
+        QVector<MatchListRow> page = repo.matchesPage(tournamentId, 0, after, pageSize);
+        for (const MatchListRow &row : page) {
+            table.rows.append({row.date, row.team1, row.team2, row.score});
+        }
+        if (page.size() < pageSize) break;
+        after.date = page.last().date;
+        after.id = page.last().id;
+    }
+    return table;
+}
+
+ReportTable ReportGenerator::headToHeadReport(SportsRepository &repo, int team1Id, int team2Id)
+{
+    ReportTable table;
+    QString team1 = repo.dictionary()->teamName(team1Id);
+    QString team2 = repo.dictionary()->teamName(team2Id);
+    table.title = QString("Очные встречи: %1 — %2").arg(team1, team2);
+    table.headers = QStringList{"Дата", "Хозяева", "Гости", "Счёт"};
+
+    // Встречи до завтрашнего дня, то есть все уже сыгранные
+    for (const HistoryRow &row : repo.headToHead(team1Id, team2Id, QDate::currentDate().addDays(1))) {
+        table.rows.append({row.date, row.team1, row.team2, row.score});
+    }
+    return table;
+}
@@ -0,0 +1,75 @@
+#ifndef REPORTGENERATOR_H
+#define REPORTGENERATOR_H
+
+#include "datatypes.h"
+#include "databaseconfig.h"
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <functional>
+
+class ConnectionPool;
+class SportsRepository;
+
+// Табличный отчёт, не зависящий от формата вывода
+struct ReportTable
+{
+    QString title;
+    QStringList headers;
+    QVector<QStringList> rows;
+};
+
+// Пакетная генерация отчётов без GUI. Каждый отчёт — отдельная задача пула
+// соединений: задачи выполняются параллельно на своих соединениях только
+// для чтения, и каждая пишет свой файл, поэтому общих данных у них нет,
+// кроме справочника команд, который после загрузки только читается.
+class ReportGenerator
+{
+public:
+    enum Format {
+        CsvFormat,
+        JsonFormat,
+        HtmlFormat
+    };
+
+    ReportGenerator(const QString &databasePath, int jobs);
+    ~ReportGenerator();
+
+    bool open();
+    QList<int> tournamentIds() const { return tournamentNames.keys(); }
+
+    void setOutput(const QString &directory, Format format);
+    void addStandings(int tournamentId);
+    void addMatches(int tournamentId);
+    void addHeadToHead(int team1Id, int team2Id);
+
+    // Выполняет все добавленные отчёты и возвращает число неудачных
+    int run();
+
+    static bool parseFormat(const QString &name, Format *format);
+    static QString extension(Format format);
+    static QString render(const ReportTable &table, Format format);
+
+    static ReportTable standingsReport(SportsRepository &repo, int tournamentId, const QString &name);
+    static ReportTable matchesReport(SportsRepository &repo, int tournamentId, const QString &name);
+    static ReportTable headToHeadReport(SportsRepository &repo, int team1Id, int team2Id);
+
+private:
+    struct Job
+    {
+        QString fileName;
+        std::function<ReportTable(SportsRepository &)> build;
+    };
+
+    DatabaseConfig config;
+    QString connectionName;
+    ConnectionPool *pool;
+    QHash<int, QString> tournamentNames;
+    QString outputDirectory;
+    Format format;
+    QVector<Job> jobs;
+};
+
+#endif // REPORTGENERATOR_H
@@ -0,0 +1,293 @@
+#include "schemamigrator.h"
+#include "sportsrepository.h"
+#include "datatypes.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStringList>
+#include <QVariant>
+#include <QDebug>
+
+namespace {
+
+struct Migration
+{
+    int version;
+    const char *description;
+    QStringList statements;
+};
+
+// Часть текстового счёта "2-1" до или после дефиса
+QString scorePartSql(const QString &score, bool home)
+{
+    return home ? QString("trim(substr(%1, 1, instr(%1, '-') - 1))").arg(score)
+                : QString("trim(substr(%1, instr(%1, '-') + 1))").arg(score);
+}
+
+// Число голов из текстового счёта или NULL, если счёт не разбирается.
+// Повторяет правила MatchResult::parse: обе части — от 1 до
+// MatchResult::MaxGoalDigits цифр без знака.
+QString goalsSql(const QString &score, bool home)
+{
+    auto isNumber = [](const QString &part) {
+        return QString("(%1 GLOB '[0-9]*' AND %1 NOT GLOB '*[^0-9]*' AND length(%1) <= %2)")
+            .arg(part).arg(MatchResult::MaxGoalDigits);
+    };
+    return QString("CASE WHEN %1 AND %2 THEN CAST(%3 AS INTEGER) END")
+        .arg(isNumber(scorePartSql(score, true)),
+             isNumber(scorePartSql(score, false)),
+             scorePartSql(score, home));
+}
+
+QString syncGoalsTriggerSql(const QString &name, const QString &event)
+{
+    return QString("CREATE TRIGGER IF NOT EXISTS %1 AFTER %2 ON matches "
+                   "BEGIN "
+                   "UPDATE matches SET home_goals = %3, away_goals = %4 WHERE id = NEW.id; "
+                   "END")
+        .arg(name, event, goalsSql("NEW.score", true), goalsSql("NEW.score", false));
+}
+
+// Текст строки таблицы, попадающий в полнотекстовый индекс
+QString searchTextSql(const QString &table, const QString &row)
+{
+    if (table == "matches") {
+        return QString("trim(coalesce(%1.venue, '') || ' ' || coalesce(%1.referee, ''))").arg(row);
+    }
+    return QString("%1.name").arg(row);
+}
+
+QString searchRowidSql(const QString &row, int kind)
+{
+    return QString("%1.id * %2 + %3").arg(row).arg(int(SearchResult::SearchKindCount)).arg(kind);
+}
+
+// Заполнение индекса существующими строками и триггеры, которые держат его
+// в актуальном состоянии. Строки индекса адресуются по rowid, поэтому
+// обновление и удаление не просматривают индекс целиком.
+QStringList searchIndexSql(const QString &table, int kind, const QString &columns)
+{
+    QString insertNew = QString("INSERT INTO search_index(rowid, name) SELECT %1, %2 WHERE %2 <> ''; ")
+                            .arg(searchRowidSql("NEW", kind), searchTextSql(table, "NEW"));
+    QString deleteOld = QString("DELETE FROM search_index WHERE rowid = %1; ")
+                            .arg(searchRowidSql("OLD", kind));
+
+    return {
+        QString("INSERT INTO search_index(rowid, name) SELECT %1, %2 FROM %3 WHERE %2 <> ''")
+            .arg(searchRowidSql(table, kind), searchTextSql(table, table), table),
+        QString("CREATE TRIGGER IF NOT EXISTS trg_search_%1_insert AFTER INSERT ON %1 BEGIN %2END")
+            .arg(table, insertNew),
+        QString("CREATE TRIGGER IF NOT EXISTS trg_search_%1_update AFTER UPDATE OF %2 ON %1 BEGIN %3%4END")
+            .arg(table, columns, deleteOld, insertNew),
+        QString("CREATE TRIGGER IF NOT EXISTS trg_search_%1_delete AFTER DELETE ON %1 BEGIN %2END")
+            .arg(table, deleteOld)
+    };
+}
+
+// Изменение итогов игроков турнира на одно событие row (NEW или OLD) со
+// знаком sign: +1 при появлении события, -1 при его удалении.
+// Голы и карточки начисляются автору, голевая передача — related_player_id гола.
+QStringList leaderTotalsSql(const QString &row, int sign)
+{
+    QString upsert =
+        "INSERT INTO player_tournament_totals"
+        "(tournament_id, player_id, team_id, goals, assists, yellow_cards, red_cards) "
+        "SELECT m.tournament_id, %1 FROM matches m WHERE m.id = %2.match_id AND %3 "
+        "ON CONFLICT(tournament_id, player_id) DO UPDATE SET "
+        "goals = goals + excluded.goals, assists = assists + excluded.assists, "
+        "yellow_cards = yellow_cards + excluded.yellow_cards, red_cards = red_cards + excluded.red_cards%4";
+    // Команда игрока берётся из последнего добавленного события
+    QString team = sign > 0 ? ", team_id = excluded.team_id" : "";
+
+    return {
+        upsert.arg(QString("%1.player_id, %1.team_id, %2 * (%1.event_type = 'goal'), 0, "
+                           "%2 * (%1.event_type = 'yellow_card'), %2 * (%1.event_type = 'red_card')")
+                       .arg(row).arg(sign),
+                   row,
+                   QString("%1.player_id IS NOT NULL AND %1.event_type IN ('goal', 'yellow_card', 'red_card')")
+                       .arg(row),
+                   team),
+        upsert.arg(QString("%1.related_player_id, %1.team_id, 0, %2, 0, 0").arg(row).arg(sign),
+                   row,
+                   QString("%1.related_player_id IS NOT NULL AND %1.event_type = 'goal'").arg(row),
+                   team)
+    };
+}
+
+QString leaderTriggerSql(const QString &name, const QString &event, const QStringList &statements)
+{
+    return QString("CREATE TRIGGER IF NOT EXISTS %1 AFTER %2 ON match_events BEGIN %3; END")
+        .arg(name, event, statements.join("; "));
+}
+
+const QVector<Migration> &migrations()
+{
+    static const QVector<Migration> list = {
+        {1, "Индексы для списка матчей, истории команд и страницы матча", {
+            // Постраничная загрузка списка матчей в порядке (date, id)
+            "CREATE INDEX IF NOT EXISTS idx_matches_tournament_date ON matches(tournament_id, date)",
+            "CREATE INDEX IF NOT EXISTS idx_matches_tournament_round_date ON matches(tournament_id, round, date)",
+            // Последние матчи команды: отдельно дома и в гостях, сразу в порядке даты
+            "CREATE INDEX IF NOT EXISTS idx_matches_team1_date ON matches(team1_id, date)",
+            "CREATE INDEX IF NOT EXISTS idx_matches_team2_date ON matches(team2_id, date)",
+            // Составы и статистика матча без временной сортировки
+            "CREATE INDEX IF NOT EXISTS idx_match_lineups_match ON match_lineups(match_id, team_id, is_starting DESC, position)",
+            "CREATE INDEX IF NOT EXISTS idx_match_stats_match ON match_stats(match_id, stat_name)",
+            "ANALYZE"
+        }},
+        {2, "Счёт матча в целочисленных столбцах home_goals/away_goals", {
+            "ALTER TABLE matches ADD COLUMN home_goals INTEGER",
+            "ALTER TABLE matches ADD COLUMN away_goals INTEGER",
+            // Заполнение существующих матчей одним проходом по таблице
+            QString("UPDATE matches SET home_goals = %1, away_goals = %2 WHERE score IS NOT NULL")
+                .arg(goalsSql("score", true), goalsSql("score", false)),
+            // Дальше столбцы поддерживаются триггерами при любой записи счёта
+            syncGoalsTriggerSql("trg_matches_goals_insert", "INSERT"),
+            syncGoalsTriggerSql("trg_matches_goals_update", "UPDATE OF score")
+        }},
+        {3, "Полнотекстовый поиск по командам, игрокам, турнирам и матчам", QStringList{
+            // Префиксные индексы ускоряют поиск по первым буквам при наборе
+            "CREATE VIRTUAL TABLE IF NOT EXISTS search_index USING fts5("
+            "name, tokenize = 'unicode61 remove_diacritics 2', prefix = '2 3')"}
+            + searchIndexSql("teams", SearchResult::SearchTeam, "name")
+            + searchIndexSql("players", SearchResult::SearchPlayer, "name")
+            + searchIndexSql("tournaments", SearchResult::SearchTournament, "name")
+            + searchIndexSql("matches", SearchResult::SearchMatch, "venue, referee")
+        },
+        {4, "Итоги игроков по турнирам для таблиц бомбардиров и дисциплины", {
+            "CREATE TABLE IF NOT EXISTS player_tournament_totals ("
+            "tournament_id INTEGER NOT NULL, player_id INTEGER NOT NULL, team_id INTEGER NOT NULL, "
+            "goals INTEGER NOT NULL DEFAULT 0, assists INTEGER NOT NULL DEFAULT 0, "
+            "yellow_cards INTEGER NOT NULL DEFAULT 0, red_cards INTEGER NOT NULL DEFAULT 0, "
+            "PRIMARY KEY (tournament_id, player_id)) WITHOUT ROWID",
+            // Существующие события суммируются один раз, дальше итоги меняют триггеры
+            "INSERT INTO player_tournament_totals"
+            "(tournament_id, player_id, team_id, goals, assists, yellow_cards, red_cards) "
+            "SELECT m.tournament_id, e.player_id, MAX(e.team_id), SUM(e.goals), SUM(e.assists), "
+            "SUM(e.yellow_cards), SUM(e.red_cards) "
+            "FROM (SELECT match_id, player_id, team_id, event_type = 'goal' AS goals, 0 AS assists, "
+            "event_type = 'yellow_card' AS yellow_cards, event_type = 'red_card' AS red_cards "
+            "FROM match_events "
+            "WHERE player_id IS NOT NULL AND event_type IN ('goal', 'yellow_card', 'red_card') "
+            "UNION ALL "
+            "SELECT match_id, related_player_id, team_id, 0, 1, 0, 0 FROM match_events "
+            "WHERE related_player_id IS NOT NULL AND event_type = 'goal') e "
+            "JOIN matches m ON m.id = e.match_id "
+            "GROUP BY m.tournament_id, e.player_id",
+            leaderTriggerSql("trg_leaders_events_insert", "INSERT", leaderTotalsSql("NEW", 1)),
+            leaderTriggerSql("trg_leaders_events_delete", "DELETE", leaderTotalsSql("OLD", -1)),
+            leaderTriggerSql("trg_leaders_events_update",
+                             "UPDATE OF match_id, event_type, player_id, related_player_id, team_id",
+                             leaderTotalsSql("OLD", -1) + leaderTotalsSql("NEW", 1))
+        }},
+        {5, "Счёт с частями длиннее четырёх цифр не переносится в home_goals/away_goals", {
+            "DROP TRIGGER IF EXISTS trg_matches_goals_insert",
+            "DROP TRIGGER IF EXISTS trg_matches_goals_update",
+            syncGoalsTriggerSql("trg_matches_goals_insert", "INSERT"),
+            syncGoalsTriggerSql("trg_matches_goals_update", "UPDATE OF score"),
+            // Пересчитываются только счета, которые прежний триггер принял
+            QString("UPDATE matches SET home_goals = NULL, away_goals = NULL "
+                    "WHERE home_goals IS NOT NULL AND (length(%1) > %3 OR length(%2) > %3)")
+                .arg(scorePartSql("score", true), scorePartSql("score", false))
+                .arg(MatchResult::MaxGoalDigits)
+        }},
+    };
+    return list;
+}
+
+} // namespace
+
+int SchemaMigrator::currentVersion(const QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (query.exec("PRAGMA user_version") && query.next()) {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+int SchemaMigrator::latestVersion()
+{
+    return migrations().last().version;
+}
+
+bool SchemaMigrator::migrate(QSqlDatabase db)
+{
+    int version = currentVersion(db);
+
+    for (const Migration &migration : migrations()) {
+        if (migration.version <= version) continue;
+
+        qDebug() << "Миграция схемы" << migration.version << ":" << migration.description;
+
+        if (!db.transaction()) {
+            qDebug() << "Не удалось начать транзакцию миграции:" << db.lastError().text();
+            return false;
+        }
+
+        QSqlQuery query(db);
+        for (const QString &statement : migration.statements) {
+            if (!query.exec(statement)) {
+                qDebug() << "Ошибка миграции" << migration.version << ":" << query.lastError().text();
+                db.rollback();
+                return false;
+            }
+        }
+
+        // PRAGMA не принимает параметры, номер версии подставляется в текст
+        if (!query.exec(QString("PRAGMA user_version = %1").arg(migration.version)) || !db.commit()) {
+            qDebug() << "Не удалось зафиксировать миграцию" << migration.version << ":"
+                     << db.lastError().text();
+            db.rollback();
+            return false;
+        }
+        version = migration.version;
+    }
+
+    return true;
+}
+
+bool SchemaMigrator::verifyIndexUsage(const QSqlDatabase &db)
+{
+    struct PlanCheck
+    {
+        const char *query;
+        QStringList expectedIndexes;
+    };
+
+    const QVector<PlanCheck> checks = {
+        {SportsRepository::recentMatchesSql(), {"idx_matches_team1_date", "idx_matches_team2_date"}},
+        {SportsRepository::headToHeadSql(), {"idx_matches_teams"}},
+        {SportsRepository::lineupsSql(), {"idx_match_lineups_match"}},
+        {SportsRepository::matchStatsSql(), {"idx_match_stats_match"}},
+    };
+
+    bool allUsed = true;
+    for (const PlanCheck &check : checks) {
+        QSqlQuery query(db);
+        query.prepare(QString("EXPLAIN QUERY PLAN ") + check.query);
+        // Значения параметров на план не влияют
+        int placeholders = QString(check.query).count('?');
+        for (int i = 0; i < placeholders; ++i) {
+            query.addBindValue(0);
+        }
+
+        if (!query.exec()) {
+            qDebug() << "Не удалось получить план запроса:" << query.lastError().text();
+            allUsed = false;
+            continue;
+        }
+
+        QString plan;
+        while (query.next()) {
+            plan += query.value(3).toString() + '\n';
+        }
+
+        for (const QString &index : check.expectedIndexes) {
+            if (!plan.contains(index)) {
+                qDebug() << "Индекс" << index << "не используется запросом:" << plan;
+                allUsed = false;
+            }
+        }
+    }
+    return allUsed;
+}
@@ -0,0 +1,22 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <QSqlDatabase>
+
+// Версионированные миграции схемы. Номер применённой миграции хранится
+// в PRAGMA user_version; каждая миграция выполняется в своей транзакции
+// и применяется ровно один раз.
+class SchemaMigrator
+{
+public:
+    static int currentVersion(const QSqlDatabase &db);
+    static int latestVersion();
+
+    static bool migrate(QSqlDatabase db);
+
+    // Проверяет через EXPLAIN QUERY PLAN, что запросы истории матчей
+    // используют предназначенные для них индексы
+    static bool verifyIndexUsage(const QSqlDatabase &db);
+};
+
+#endif // SCHEMAMIGRATOR_H
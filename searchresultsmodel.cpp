@@ -0,0 +1,38 @@
+#include "searchresultsmodel.h"
+
+SearchResultsModel::SearchResultsModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+void SearchResultsModel::setRows(const QVector<SearchResult> &newRows)
+{
+    beginResetModel();
+    rows = newRows;
+    endResetModel();
+}
+
+void SearchResultsModel::clear()
+{
+    setRows(QVector<SearchResult>());
+}
+
+int SearchResultsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+QVariant SearchResultsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+
+    const SearchResult &row = rows.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return row.subtitle.isEmpty() ? row.title : row.title + "\n" + row.subtitle;
+    case Qt::ToolTipRole:
+        // Куда ведёт результат: без турнира переход невозможен
+        return row.tournamentName.isEmpty() ? QVariant() : QVariant("Открыть: " + row.tournamentName);
+    }
+    return QVariant();
+}
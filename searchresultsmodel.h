@@ -0,0 +1,28 @@
+#ifndef SEARCHRESULTSMODEL_H
+#define SEARCHRESULTSMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractListModel>
+
+// Результаты полнотекстового поиска: название и под ним вид результата
+// с подробностями (команда игрока, дата и стадион матча).
+class SearchResultsModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit SearchResultsModel(QObject *parent = nullptr);
+
+    void setRows(const QVector<SearchResult> &rows);
+    void clear();
+    const SearchResult &resultAt(int row) const { return rows.at(row); }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    QVector<SearchResult> rows;
+};
+
+#endif // SEARCHRESULTSMODEL_H
@@ -0,0 +1,279 @@
+#include "seasonsimulator.h"
+#include "tracing.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QHash>
+#include <QVariant>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace {
+
+// Средние голы хозяев и гостей, если в турнире ещё нет сыгранных матчей
+const double DefaultHomeGoals = 1.5;
+const double DefaultAwayGoals = 1.2;
+
+// Сколько матчей весит априорная сила 1.0 при оценке атаки и защиты:
+// в начале сезона команды не получают крайних оценок по паре игр
+const double PriorMatches = 5.0;
+
+// Начиная с этого ожидания метод Кнута медленный, а exp(-λ) теряет точность,
+// и Пуассон заменяется нормальным приближением
+const double LargeRate = 30.0;
+
+// Число голов ~ Poisson(λ); expNeg = exp(-λ) для метода Кнута при малом λ
+int poissonGoals(double rate, double expNeg, std::mt19937_64 &rng)
+{
+    if (rate >= LargeRate) {
+        std::normal_distribution<double> normal(rate, std::sqrt(rate));
+        return std::max(0, int(std::lround(normal(rng))));
+    }
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    int goals = 0;
+    double product = uniform(rng);
+    while (product > expNeg) {
+        ++goals;
+        product *= uniform(rng);
+    }
+    return goals;
+}
+
+double strength(double perMatch, double leagueAverage, int played)
+{
+    if (leagueAverage <= 0.0) return 1.0;
+    double ratio = perMatch / leagueAverage;
+    return (ratio * played + PriorMatches) / (played + PriorMatches);
+}
+
+} // namespace
+
+bool SeasonSimulator::load(const QSqlDatabase &db, int tournamentId, SportKind sportKind,
+                           const QVector<StandingRow> &table)
+{
+    sport = sportKind;
+    teamIds.clear();
+    baseTable.clear();
+    homeTeam.clear();
+    awayTeam.clear();
+    homeRate.clear();
+    awayRate.clear();
+    homeExpNeg.clear();
+    awayExpNeg.clear();
+
+    QHash<int, int> indexByTeam;
+    for (const StandingRow &row : table) {
+        indexByTeam.insert(row.teamId, int(teamIds.size()));
+        teamIds.push_back(row.teamId);
+        TeamState state;
+        state.points = row.points;
+        state.wins = row.wins;
+        state.goalsFor = row.goalsFor;
+        state.goalsAgainst = row.goalsAgainst;
+        baseTable.push_back(state);
+    }
+
+    // Средние голы хозяев и гостей по сыгранным матчам турнира
+    double homeAverage = DefaultHomeGoals;
+    double awayAverage = DefaultAwayGoals;
+    QSqlQuery averages(db);
+    averages.prepare(
+        "SELECT AVG(home_goals), AVG(away_goals) FROM matches "
+        "WHERE tournament_id = ? AND home_goals IS NOT NULL "
+        "AND (match_status IS NULL OR match_status = 'finished')"
+    );
+    averages.addBindValue(tournamentId);
+    if (!averages.exec()) {
+        qDebug() << "Ошибка расчёта средней результативности:" << averages.lastError().text();
+        return false;
+    }
+    if (averages.next() && !averages.value(0).isNull()) {
+        homeAverage = averages.value(0).toDouble();
+        awayAverage = averages.value(1).toDouble();
+    }
+    double goalAverage = (homeAverage + awayAverage) / 2.0;
+
+    std::vector<double> attack(teamIds.size(), 1.0);
+    std::vector<double> defence(teamIds.size(), 1.0);
+    for (int i = 0; i < table.size(); ++i) {
+        const StandingRow &row = table[i];
+        if (row.played <= 0) continue;
+        attack[i] = strength(double(row.goalsFor) / row.played, goalAverage, row.played);
+        defence[i] = strength(double(row.goalsAgainst) / row.played, goalAverage, row.played);
+    }
+
+    // Оставшиеся матчи: всё, что ещё не учтено в таблице, кроме отменённых
+    QSqlQuery query(db);
+    query.prepare(
+        "SELECT team1_id, team2_id FROM matches "
+        "WHERE tournament_id = ? "
+        "AND COALESCE(match_status, '') <> 'canceled' "
+        "AND NOT (home_goals IS NOT NULL AND (match_status IS NULL OR match_status = 'finished'))"
+    );
+    query.addBindValue(tournamentId);
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки оставшихся матчей:" << query.lastError().text();
+        return false;
+    }
+
+    while (query.next()) {
+        int home = indexByTeam.value(query.value(0).toInt(), -1);
+        int away = indexByTeam.value(query.value(1).toInt(), -1);
+        if (home < 0 || away < 0) continue;
+
+        homeTeam.push_back(quint16(home));
+        awayTeam.push_back(quint16(away));
+        homeRate.push_back(homeAverage * attack[home] * defence[away]);
+        awayRate.push_back(awayAverage * attack[away] * defence[home]);
+        homeExpNeg.push_back(std::exp(-homeRate.back()));
+        awayExpNeg.push_back(std::exp(-awayRate.back()));
+    }
+    return true;
+}
+
+QVector<SeasonProjection> SeasonSimulator::run(int iterations, const std::function<bool()> &cancelled) const
+{
+    TRACE_SCOPE_CATEGORY("SeasonSimulator::run", "compute");
+    QVector<SeasonProjection> result;
+    if (teamIds.empty()) return result;
+
+    // Без оставшихся матчей исход один, достаточно одного прогона
+    if (homeTeam.empty()) iterations = 1;
+
+    int threadCount = int(std::max(1u, std::thread::hardware_concurrency()));
+    threadCount = std::min(threadCount, std::max(1, iterations / 1000));
+
+    std::vector<Tally> tallies(threadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    std::random_device device;
+    const quint64 seed = (quint64(device()) << 32) ^ device();
+
+    withSportRules(sport, [&](auto rules) {
+        using Rules = decltype(rules);
+        for (int t = 0; t < threadCount; ++t) {
+            int share = iterations / threadCount + (t < iterations % threadCount ? 1 : 0);
+            quint64 threadSeed = seed + 0x9E3779B97F4A7C15ULL * quint64(t + 1);
+            threads.emplace_back(&SeasonSimulator::simulate<Rules>, this, share, threadSeed,
+                                 std::cref(cancelled), &tallies[t]);
+        }
+    });
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    // Счётчики потоков складываются только после join
+    Tally total;
+    total.title.assign(teamIds.size(), 0);
+    total.europe.assign(teamIds.size(), 0);
+    total.relegation.assign(teamIds.size(), 0);
+    total.points.assign(teamIds.size(), 0);
+    for (const Tally &tally : tallies) {
+        total.iterations += tally.iterations;
+        for (size_t i = 0; i < teamIds.size(); ++i) {
+            total.title[i] += tally.title[i];
+            total.europe[i] += tally.europe[i];
+            total.relegation[i] += tally.relegation[i];
+            total.points[i] += tally.points[i];
+        }
+    }
+    if (total.iterations == 0) return result;
+
+    result.reserve(int(teamIds.size()));
+    const double count = total.iterations;
+    for (size_t i = 0; i < teamIds.size(); ++i) {
+        SeasonProjection projection;
+        projection.teamId = teamIds[i];
+        projection.title = total.title[i] / count;
+        projection.europe = total.europe[i] / count;
+        projection.relegation = total.relegation[i] / count;
+        projection.expectedPoints = total.points[i] / count;
+        result.append(projection);
+    }
+    return result;
+}
+
+template <typename Rules>
+void SeasonSimulator::simulate(int iterations, quint64 seed, const std::function<bool()> &cancelled,
+                               Tally *tally) const
+{
+    TRACE_SCOPE_CATEGORY("SeasonSimulator::simulate", "compute");
+    const size_t teams = teamIds.size();
+    const size_t matches = homeTeam.size();
+
+    tally->title.assign(teams, 0);
+    tally->europe.assign(teams, 0);
+    tally->relegation.assign(teams, 0);
+    tally->points.assign(teams, 0);
+
+    std::mt19937_64 rng(seed);
+    std::vector<TeamState> table(teams);
+    std::vector<int> order(teams);
+
+    for (int n = 0; n < iterations; ++n) {
+        if (cancelled && (n & 1023) == 0 && cancelled()) return;
+
+        table = baseTable;
+
+        for (size_t m = 0; m < matches; ++m) {
+            TeamState &home = table[homeTeam[m]];
+            TeamState &away = table[awayTeam[m]];
+            int homeGoals = poissonGoals(homeRate[m], homeExpNeg[m], rng);
+            int awayGoals = poissonGoals(awayRate[m], awayExpNeg[m], rng);
+
+            // Без ничьих равный счёт решает дополнительное время: побеждает
+            // команда, выигравшая его с вероятностью по соотношению сил
+            if (!Rules::HasDraws && homeGoals == awayGoals) {
+                std::uniform_real_distribution<double> uniform(0.0, 1.0);
+                const double total = homeRate[m] + awayRate[m];
+                const double homeShare = total > 0.0 ? homeRate[m] / total : 0.5;
+                if (uniform(rng) < homeShare) {
+                    ++homeGoals;
+                } else {
+                    ++awayGoals;
+                }
+            }
+
+            home.goalsFor += homeGoals;
+            home.goalsAgainst += awayGoals;
+            away.goalsFor += awayGoals;
+            away.goalsAgainst += homeGoals;
+            if (homeGoals > awayGoals) {
+                home.points += Rules::WinPoints;
+                home.wins++;
+                away.points += Rules::LossPoints;
+            } else if (homeGoals < awayGoals) {
+                away.points += Rules::WinPoints;
+                away.wins++;
+                home.points += Rules::LossPoints;
+            } else {
+                home.points += Rules::DrawPoints;
+                away.points += Rules::DrawPoints;
+            }
+        }
+
+        // Порядок мест как в StandingsEngine; при полном равенстве выше та,
+        // что выше в текущей таблице
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            const int byRules = Rules::compare(table[a], table[b]);
+            if (byRules != 0) return byRules < 0;
+            return a < b;
+        });
+
+        for (size_t position = 0; position < teams; ++position) {
+            const int team = order[position];
+            const StandingZone zone = standingZone<Rules>(int(position) + 1, int(teams));
+            if (position == 0) tally->title[team]++;
+            if (zone == PromotionZone || zone == QualificationZone) tally->europe[team]++;
+            if (zone == RelegationZone) tally->relegation[team]++;
+            tally->points[team] += quint64(table[team].points);
+        }
+        tally->iterations++;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef SEASONSIMULATOR_H
+#define SEASONSIMULATOR_H
+
+#include "datatypes.h"
+#include "sportrules.h"
+
+#include <QSqlDatabase>
+#include <functional>
+#include <vector>
+
+// Моделирование оставшейся части сезона методом Монте-Карло.
+// Оставшиеся матчи хранятся плоскими массивами (по массиву на поле), а
+// таблица — массивом коротких записей, чтобы внутренний цикл читал память
+// подряд. Очки, порядок мест и зоны считаются по правилам вида спорта;
+// цикл прогонов инстанцируется отдельно для каждых правил.
+// Голы каждого матча разыгрываются по распределению Пуассона с ожиданием
+// из силы атаки и защиты команд; при большом ожидании (баскетбол) — по его
+// нормальному приближению. В видах спорта без ничьих равный счёт
+// разыгрывается как дополнительное время. Прогоны делятся между потоками поровну;
+// у каждого потока свой генератор и свои счётчики, которые суммируются
+// после завершения всех потоков, поэтому блокировок нет.
+class SeasonSimulator
+{
+public:
+    bool load(const QSqlDatabase &db, int tournamentId, SportKind sport, const QVector<StandingRow> &table);
+
+    int teamCount() const { return int(teamIds.size()); }
+    int remainingMatches() const { return int(homeTeam.size()); }
+
+    // cancelled вызывается из рабочих потоков и должен быть потокобезопасным
+    QVector<SeasonProjection> run(int iterations,
+                                  const std::function<bool()> &cancelled = std::function<bool()>()) const;
+
+private:
+    struct Tally
+    {
+        std::vector<quint32> title;
+        std::vector<quint32> europe;
+        std::vector<quint32> relegation;
+        std::vector<quint64> points;
+        int iterations = 0;
+    };
+
+    // Поля, которые сравнивают правила вида спорта
+    struct TeamState
+    {
+        int points = 0;
+        int wins = 0;
+        int goalsFor = 0;
+        int goalsAgainst = 0;
+    };
+
+    template <typename Rules>
+    void simulate(int iterations, quint64 seed, const std::function<bool()> &cancelled, Tally *tally) const;
+
+    SportKind sport = SportKind::Football;
+
+    // Команды в порядке текущей таблицы
+    std::vector<int> teamIds;
+    std::vector<TeamState> baseTable;
+
+    // Оставшиеся матчи: индексы команд, ожидаемые голы λ и exp(-λ) для их розыгрыша
+    std::vector<quint16> homeTeam;
+    std::vector<quint16> awayTeam;
+    std::vector<double> homeRate;
+    std::vector<double> awayRate;
+    std::vector<double> homeExpNeg;
+    std::vector<double> awayExpNeg;
+};
+
+#endif // SEASONSIMULATOR_H
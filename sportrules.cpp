@@ -0,0 +1,21 @@
+#include "sportrules.h"
+
+SportKind sportKindFromName(const QString &sportName)
+{
+    const QString name = sportName.trimmed().toLower();
+    // Хоккей с мячом играют по футбольной системе очков
+    if (name == QString("хоккей с шайбой") || name == "hockey" || name == "ice hockey") {
+        return SportKind::Hockey;
+    }
+    if (name == QString("баскетбол") || name == "basketball") {
+        return SportKind::Basketball;
+    }
+    return SportKind::Football;
+}
+
+StandingZone standingZone(SportKind kind, int position, int teamCount)
+{
+    return withSportRules(kind, [position, teamCount](auto rules) {
+        return standingZone<decltype(rules)>(position, teamCount);
+    });
+}
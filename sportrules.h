@@ -0,0 +1,142 @@
+#ifndef SPORTRULES_H
+#define SPORTRULES_H
+
+#include "datatypes.h"
+
+#include <QString>
+
+// Правила турнирной таблицы по видам спорта: очки за исход, цепочка
+// дополнительных показателей при равенстве очков и зоны таблицы.
+// Правила — типы с константами и шаблонными функциями; вид спорта
+// выбирается один раз (withSportRules), а подсчёт очков и сортировка
+// инстанцируются под конкретные правила без ветвлений внутри циклов.
+//
+// Record — любая строка таблицы с полями points, wins, goalsFor, goalsAgainst.
+// HasDraws — может ли матч закончиться вничью; иначе при равном счёте
+// победитель определяется в дополнительное время.
+
+enum class SportKind {
+    Football,
+    Hockey,
+    Basketball
+};
+
+// Футбол: 3 очка за победу, 1 за ничью. Зоны: 4 места Лиги чемпионов,
+// ещё 2 еврокубковых, последние 3 команды выбывают.
+struct FootballRules
+{
+    static constexpr SportKind Kind = SportKind::Football;
+
+    static constexpr int WinPoints = 3;
+    static constexpr int DrawPoints = 1;
+    static constexpr int LossPoints = 0;
+    static constexpr bool HasDraws = true;
+
+    static constexpr int PromotionPlaces = 4;
+    static constexpr int QualificationPlaces = 6;
+    static constexpr int RelegationPlaces = 3;
+
+    // Отрицательное значение — a выше b. Очки, разница мячей, забитые, победы
+    template <typename Record>
+    static int compare(const Record &a, const Record &b)
+    {
+        if (a.points != b.points) return b.points - a.points;
+        const int diffA = a.goalsFor - a.goalsAgainst;
+        const int diffB = b.goalsFor - b.goalsAgainst;
+        if (diffA != diffB) return diffB - diffA;
+        if (a.goalsFor != b.goalsFor) return b.goalsFor - a.goalsFor;
+        return b.wins - a.wins;
+    }
+};
+
+// Хоккей: 2 очка за победу. Победа в овертайме или по буллитам в схеме не
+// отличается от основного времени, а сохранённая ничья даёт по очку.
+// Выше при равенстве очков команда с большим числом побед. В плей-офф
+// выходят 8 команд, вылета нет.
+struct HockeyRules
+{
+    static constexpr SportKind Kind = SportKind::Hockey;
+
+    static constexpr int WinPoints = 2;
+    static constexpr int DrawPoints = 1;
+    static constexpr int LossPoints = 0;
+    static constexpr bool HasDraws = true;
+
+    static constexpr int PromotionPlaces = 8;
+    static constexpr int QualificationPlaces = 0;
+    static constexpr int RelegationPlaces = 0;
+
+    template <typename Record>
+    static int compare(const Record &a, const Record &b)
+    {
+        if (a.points != b.points) return b.points - a.points;
+        if (a.wins != b.wins) return b.wins - a.wins;
+        const int diffA = a.goalsFor - a.goalsAgainst;
+        const int diffB = b.goalsFor - b.goalsAgainst;
+        if (diffA != diffB) return diffB - diffA;
+        return b.goalsFor - a.goalsFor;
+    }
+};
+
+// Баскетбол (правила FIBA): 2 очка за победу и 1 за поражение, ничьих
+// не бывает — ошибочно записанная ничья считается поражением обеих команд.
+// Порядок: очки, победы, разница набранных очков. В плей-офф выходят 8 команд.
+struct BasketballRules
+{
+    static constexpr SportKind Kind = SportKind::Basketball;
+
+    static constexpr int WinPoints = 2;
+    static constexpr int DrawPoints = 1;        // не используется: HasDraws == false
+    static constexpr int LossPoints = 1;
+    static constexpr bool HasDraws = false;
+
+    static constexpr int PromotionPlaces = 8;
+    static constexpr int QualificationPlaces = 0;
+    static constexpr int RelegationPlaces = 0;
+
+    template <typename Record>
+    static int compare(const Record &a, const Record &b)
+    {
+        if (a.points != b.points) return b.points - a.points;
+        if (a.wins != b.wins) return b.wins - a.wins;
+        const int diffA = a.goalsFor - a.goalsAgainst;
+        const int diffB = b.goalsFor - b.goalsAgainst;
+        if (diffA != diffB) return diffB - diffA;
+        return b.goalsFor - a.goalsFor;
+    }
+};
+
+// Зона места position (с 1) в таблице из teamCount команд
+template <typename Rules>
+StandingZone standingZone(int position, int teamCount)
+{
+    if (position <= Rules::PromotionPlaces) return PromotionZone;
+    if (position <= Rules::QualificationPlaces) return QualificationZone;
+    if (Rules::RelegationPlaces > 0 && position > teamCount - Rules::RelegationPlaces) return RelegationZone;
+    return NoZone;
+}
+
+// Вызывает visitor с объектом правил вида спорта; тело visitor
+// инстанцируется отдельно для каждого типа правил
+template <typename Visitor>
+decltype(auto) withSportRules(SportKind kind, Visitor &&visitor)
+{
+    switch (kind) {
+    case SportKind::Hockey:
+        return visitor(HockeyRules());
+    case SportKind::Basketball:
+        return visitor(BasketballRules());
+    case SportKind::Football:
+        break;
+    }
+    return visitor(FootballRules());
+}
+
+// Вид спорта по названию из таблицы sports. id видов спорта в разных БД
+// разные, поэтому id сопоставляется с правилами через название; неизвестные
+// виды спорта считаются по футбольным правилам.
+SportKind sportKindFromName(const QString &sportName);
+
+StandingZone standingZone(SportKind kind, int position, int teamCount);
+
+#endif // SPORTRULES_H
@@ -0,0 +1,626 @@
+#include "sportsrepository.h"
+#include "teamdictionary.h"
+#include "statcatalogue.h"
+#include <QSqlError>
+#include <QVariant>
+#include <QRegularExpression>
+#include <QDebug>
+
+SportsRepository::SportsRepository(const QSqlDatabase &db)
+    : db(db),
+      names(std::make_shared<TeamDictionary>()),
+      statements(db)
+{
+}
+
+void SportsRepository::setDictionary(const std::shared_ptr<const TeamDictionary> &dictionary)
+{
+    if (dictionary) {
+        names = dictionary;
+    }
+}
+
+void SportsRepository::logStatementStats(const QString &connectionName) const
+{
+    // Включается переменной окружения SPORTSTRACKER_SQL_STATS
+    if (!qEnvironmentVariableIsSet("SPORTSTRACKER_SQL_STATS")) return;
+
+    for (const StatementCache::Stats &entry : statements.stats()) {
+        if (entry.executions == 0) continue;
+        qDebug().noquote() << QString("[%1] %2 выполн., %3 строк, всего %4 мс, макс. %5 мс: %6")
+            .arg(connectionName)
+            .arg(entry.executions)
+            .arg(entry.rows)
+            .arg(entry.totalNs / 1e6, 0, 'f', 2)
+            .arg(entry.maxNs / 1e6, 0, 'f', 2)
+            .arg(entry.sql.simplified());
+    }
+}
+
+const char *SportsRepository::matchStatsSql()
+{
+    return "SELECT stat_name, team_id, stat_value FROM match_stats "
+           "WHERE match_id = ? ORDER BY stat_name";
+}
+
+const char *SportsRepository::lineupsSql()
+{
+    return "SELECT player_id, team_id, position, is_starting, jersey_number "
+           "FROM match_lineups "
+           "WHERE match_id = ? "
+           "ORDER BY team_id, is_starting DESC, position";
+}
+
+const char *SportsRepository::recentMatchesSql()
+{
+    // Условие "team1_id = ? OR team2_id = ?" не позволяет использовать индекс,
+    // поэтому домашние и гостевые матчи читаются по своим индексам (team, date)
+    // и объединяются: каждая ветка читает не больше пяти строк
+    return "SELECT date, team1_id, team2_id, score FROM ("
+           "SELECT date, team1_id, team2_id, score FROM matches "
+           "WHERE team1_id = ? AND date < ? ORDER BY date DESC LIMIT 5) "
+           "UNION ALL "
+           "SELECT date, team1_id, team2_id, score FROM ("
+           "SELECT date, team1_id, team2_id, score FROM matches "
+           "WHERE team2_id = ? AND date < ? ORDER BY date DESC LIMIT 5) "
+           "ORDER BY date DESC LIMIT 5";
+}
+
+const char *SportsRepository::headToHeadSql()
+{
+    return "SELECT date, team1_id, team2_id, score FROM matches "
+           "WHERE team1_id = ? AND team2_id = ? AND date < ? "
+           "UNION ALL "
+           "SELECT date, team1_id, team2_id, score FROM matches "
+           "WHERE team1_id = ? AND team2_id = ? AND date < ? "
+           "ORDER BY date DESC LIMIT 10";
+}
+
+MatchHeader SportsRepository::headerFor(const MatchListRow &row)
+{
+    MatchHeader header;
+    header.id = row.id;
+    header.team1Id = row.team1Id;
+    header.team2Id = row.team2Id;
+    header.team1 = row.team1;
+    header.team2 = row.team2;
+    header.date = QDate::fromString(row.date.left(10), Qt::ISODate);
+    return header;
+}
+
+QVector<SportRow> SportsRepository::sports()
+{
+    QVector<SportRow> result;
+
+    StatementCache::Run query(statements, "SELECT id, name FROM sports ORDER BY name");
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки видов спорта:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        SportRow row;
+        row.id = query.value(0).toInt();
+        row.name = query.value(1).toString();
+        result.append(row);
+    }
+    return result;
+}
+
+QVector<TournamentRow> SportsRepository::tournaments(int sportId)
+{
+    QVector<TournamentRow> result;
+
+    StatementCache::Run query(statements, "SELECT id, name FROM tournaments WHERE sport_id = ? ORDER BY name");
+    query.bind(0, sportId);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки турниров:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        TournamentRow row;
+        row.id = query.value(0).toInt();
+        row.sportId = sportId;
+        row.name = query.value(1).toString();
+        result.append(row);
+    }
+    return result;
+}
+
+QVector<RoundInfo> SportsRepository::rounds(int tournamentId)
+{
+    QVector<RoundInfo> result;
+
+    // Все туры турнира одним проходом по индексу (tournament_id, round, date):
+    // группировка идёт в порядке индекса без временной сортировки
+    StatementCache::Run query(statements,
+        "SELECT round, COUNT(*), MIN(date), MAX(date), "
+        "SUM(CASE WHEN score IS NOT NULL AND (match_status IS NULL OR match_status = 'finished') "
+        "THEN 1 ELSE 0 END) "
+        "FROM matches "
+        "WHERE tournament_id = ? "
+        "GROUP BY round "
+        "ORDER BY round"
+    );
+    query.bind(0, tournamentId);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки туров:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        RoundInfo info;
+        info.round = query.value(0).toInt();
+        info.matchCount = query.value(1).toInt();
+        info.firstDate = query.value(2).toString();
+        info.lastDate = query.value(3).toString();
+        info.finishedCount = query.value(4).toInt();
+        result.append(info);
+    }
+    return result;
+}
+
+QVector<MatchListRow> SportsRepository::matchesPage(int tournamentId, int round,
+                                                    const MatchPageCursor &after, int limit)
+{
+    QVector<MatchListRow> result;
+
+    // Keyset-пагинация: вместо OFFSET продолжаем с последней загруженной пары (date, id),
+    // поэтому каждая страница читает из индекса только свои строки
+    QString queryStr =
+        "SELECT m.id, m.date, m.team1_id, m.team2_id, "
+        "CASE WHEN m.score IS NULL THEN '-' ELSE m.score END as score "
+        "FROM matches m "
+        "WHERE m.tournament_id = ? ";
+
+    if (round > 0) {
+        queryStr += "AND m.round = ? ";
+    }
+
+    if (after.isValid()) {
+        queryStr += "AND (m.date, m.id) < (?, ?) ";
+    }
+
+    queryStr += "ORDER BY m.date DESC, m.id DESC LIMIT ?";
+
+    // Каждый из четырёх вариантов текста готовится один раз и дальше переиспользуется
+    StatementCache::Run query(statements, queryStr);
+    int position = 0;
+    query.bind(position++, tournamentId);
+
+    if (round > 0) {
+        query.bind(position++, round);
+    }
+
+    if (after.isValid()) {
+        query.bind(position++, after.date);
+        query.bind(position++, after.id);
+    }
+
+    query.bind(position++, limit);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки матчей:" << query.lastError().text();
+        return result;
+    }
+
+    result.reserve(limit);
+    while (query.next()) {
+        MatchListRow row;
+        row.id = query.value(0).toInt();
+        row.date = query.value(1).toString();
+        row.team1Id = query.value(2).toInt();
+        row.team2Id = query.value(3).toInt();
+        row.team1 = names->teamName(row.team1Id);
+        row.team2 = names->teamName(row.team2Id);
+        row.score = query.value(4).toString();
+        result.append(row);
+    }
+    return result;
+}
+
+QVector<StandingRow> SportsRepository::standings(int tournamentId)
+{
+    QVector<StandingRow> result;
+
+    StatementCache::Run query(statements,
+        "SELECT s.position, s.team_id, s.points, s.games_played, s.wins, s.draws, s.losses, "
+        "s.goals_for, s.goals_against "
+        "FROM standings s "
+        "WHERE s.tournament_id = ? "
+        "ORDER BY s.position"
+    );
+    query.bind(0, tournamentId);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки турнирной таблицы:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        StandingRow row;
+        row.position = query.value(0).toInt();
+        row.teamId = query.value(1).toInt();
+        row.team = names->teamName(row.teamId);
+        row.points = query.value(2).toInt();
+        row.played = query.value(3).toInt();
+        row.wins = query.value(4).toInt();
+        row.draws = query.value(5).toInt();
+        row.losses = query.value(6).toInt();
+        row.goalsFor = query.value(7).toInt();
+        row.goalsAgainst = query.value(8).toInt();
+        result.append(row);
+    }
+
+    // Места уже упорядочены по правилам вида спорта, границы зон зависят от них же
+    if (!result.isEmpty()) {
+        const SportKind kind = sportKind(tournamentId);
+        for (StandingRow &row : result) {
+            row.zone = standingZone(kind, row.position, result.size());
+        }
+    }
+    return result;
+}
+
+SportKind SportsRepository::sportKind(int tournamentId)
+{
+    StatementCache::Run query(statements,
+        "SELECT s.name FROM tournaments t JOIN sports s ON s.id = t.sport_id WHERE t.id = ?");
+    query.bind(0, tournamentId);
+
+    if (!query.exec() || !query.next()) {
+        return SportKind::Football;
+    }
+    return sportKindFromName(query.value(0).toString());
+}
+
+bool SportsRepository::matchHeader(int matchId, MatchHeader *header)
+{
+    StatementCache::Run query(statements, "SELECT team1_id, team2_id, date FROM matches WHERE id = ?");
+    query.bind(0, matchId);
+
+    if (!query.exec() || !query.next()) {
+        qDebug() << "Ошибка загрузки данных матча:" << query.lastError().text();
+        return false;
+    }
+
+    header->id = matchId;
+    header->team1Id = query.value(0).toInt();
+    header->team2Id = query.value(1).toInt();
+    header->team1 = names->teamName(header->team1Id);
+    header->team2 = names->teamName(header->team2Id);
+    header->date = QDate::fromString(query.value(2).toString().left(10), Qt::ISODate);
+    return true;
+}
+
+QVector<StatRow> SportsRepository::matchStats(const MatchHeader &header)
+{
+    QVector<StatRow> result;
+
+    // Обе стороны показателя читаются одним проходом и сводятся в строку здесь,
+    // без коррелированных подзапросов и поиска команд по имени
+    StatementCache::Run query(statements, matchStatsSql());
+    query.bind(0, header.id);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки статистики матча:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        QString name = query.value(0).toString();
+        if (result.isEmpty() || result.last().name != name) {
+            StatRow row;
+            row.name = name;
+            result.append(row);
+        }
+
+        int teamId = query.value(1).toInt();
+        if (teamId == header.team1Id) {
+            result.last().team1Value = query.value(2).toString();
+        } else if (teamId == header.team2Id) {
+            result.last().team2Value = query.value(2).toString();
+        }
+    }
+    return result;
+}
+
+QVector<LineupEntry> SportsRepository::lineups(const MatchHeader &header)
+{
+    QVector<LineupEntry> result;
+
+    StatementCache::Run query(statements, lineupsSql());
+    query.bind(0, header.id);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки составов:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        LineupEntry entry;
+        entry.name = names->playerName(query.value(0).toInt());
+        entry.teamId = query.value(1).toInt();
+        entry.position = query.value(2).toString();
+        entry.starting = query.value(3).toBool();
+        entry.jersey = query.value(4).toString();
+        result.append(entry);
+    }
+    return result;
+}
+
+QVector<EventRow> SportsRepository::events(const MatchHeader &header)
+{
+    QVector<EventRow> result;
+
+    StatementCache::Run query(statements,
+        "SELECT event_type, minute, player_id, description, team_id "
+        "FROM match_events "
+        "WHERE match_id = ? "
+        "ORDER BY minute"
+    );
+    query.bind(0, header.id);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки событий матча:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        EventRow row;
+        row.type = query.value(0).toString();
+        row.minute = query.value(1).toInt();
+        if (!query.value(2).isNull()) {
+            row.player = names->playerName(query.value(2).toInt());
+        }
+        row.description = query.value(3).toString();
+        row.teamId = query.value(4).toInt();
+        result.append(row);
+    }
+    return result;
+}
+
+QVector<HistoryRow> SportsRepository::recentMatches(int teamId, const QDate &beforeDate)
+{
+    QVector<HistoryRow> result;
+
+    QString before = beforeDate.toString(Qt::ISODate);
+    StatementCache::Run query(statements, recentMatchesSql());
+    query.bind(0, teamId);
+    query.bind(1, before);
+    query.bind(2, teamId);
+    query.bind(3, before);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки последних матчей:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        HistoryRow row;
+        row.date = query.value(0).toString();
+        row.team1 = names->teamName(query.value(1).toInt());
+        row.team2 = names->teamName(query.value(2).toInt());
+        row.score = query.value(3).toString();
+        result.append(row);
+    }
+    return result;
+}
+
+QVector<HistoryRow> SportsRepository::headToHead(int team1Id, int team2Id, const QDate &beforeDate)
+{
+    QVector<HistoryRow> result;
+
+    QString before = beforeDate.toString(Qt::ISODate);
+    StatementCache::Run query(statements, headToHeadSql());
+    query.bind(0, team1Id);
+    query.bind(1, team2Id);
+    query.bind(2, before);
+    query.bind(3, team2Id);
+    query.bind(4, team1Id);
+    query.bind(5, before);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки очных встреч:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        HistoryRow row;
+        row.date = query.value(0).toString();
+        row.team1 = names->teamName(query.value(1).toInt());
+        row.team2 = names->teamName(query.value(2).toInt());
+        row.score = query.value(3).toString();
+        result.append(row);
+    }
+    return result;
+}
+
+QVector<LeaderRow> SportsRepository::playerTotals(int tournamentId)
+{
+    QVector<LeaderRow> result;
+
+    StatementCache::Run query(statements,
+        "SELECT player_id, team_id, goals, assists, yellow_cards, red_cards "
+        "FROM player_tournament_totals WHERE tournament_id = ?");
+    query.bind(0, tournamentId);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки итогов игроков:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        LeaderRow row;
+        row.playerId = query.value(0).toInt();
+        row.teamId = query.value(1).toInt();
+        row.player = names->playerName(row.playerId);
+        row.team = names->teamName(row.teamId);
+        row.goals = query.value(2).toInt();
+        row.assists = query.value(3).toInt();
+        row.yellowCards = query.value(4).toInt();
+        row.redCards = query.value(5).toInt();
+        result.append(row);
+    }
+    return result;
+}
+
+QVector<TeamStatSamples> SportsRepository::teamStatSamples(int tournamentId)
+{
+    QVector<TeamStatSamples> result;
+
+    // Один проход по статистике турнира; сортировка даёт каждому показателю
+    // непрерывный столбец, а в нём — непрерывный отрезок каждой команды
+    StatementCache::Run query(statements,
+        "SELECT ms.stat_name, ms.team_id, ms.stat_value "
+        "FROM match_stats ms JOIN matches m ON m.id = ms.match_id "
+        "WHERE m.tournament_id = ? "
+        "ORDER BY ms.stat_name, ms.team_id");
+    query.bind(0, tournamentId);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка загрузки статистики команд:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        double value;
+        if (!StatCatalogue::parse(query.value(2).toString(), &value)) continue;
+
+        QString stat = query.value(0).toString();
+        if (result.isEmpty() || result.last().stat != stat) {
+            TeamStatSamples samples;
+            samples.stat = stat;
+            result.append(samples);
+        }
+        result.last().teamIds.append(query.value(1).toInt());
+        result.last().values.append(value);
+    }
+    return result;
+}
+
+qint64 SportsRepository::dataVersion()
+{
+    StatementCache::Run query(statements, "PRAGMA data_version");
+    if (!query.exec() || !query.next()) {
+        return -1;
+    }
+    return query.value(0).toLongLong();
+}
+
+QString SportsRepository::searchExpression(const QString &text)
+{
+    // Каждое слово ищется как префикс, все слова должны встретиться в строке.
+    // Кавычки превращают слово в строку FTS5, чтобы операторы в нём не разбирались
+    QStringList terms;
+    for (QString word : text.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts)) {
+        word.remove('"');
+        if (!word.isEmpty()) {
+            terms.append(QString("\"%1\"*").arg(word));
+        }
+    }
+    return terms.join(' ');
+}
+
+QVector<SearchResult> SportsRepository::search(const QString &text, int limit)
+{
+    QVector<SearchResult> result;
+
+    QString expression = searchExpression(text);
+    if (expression.isEmpty()) return result;
+
+    {
+        // Сначала лучшие по рангу строки индекса, затем подробности по первичным ключам
+        StatementCache::Run query(statements,
+            "SELECT rowid, name FROM search_index WHERE search_index MATCH ? ORDER BY rank LIMIT ?");
+        query.bind(0, expression);
+        query.bind(1, limit);
+
+        if (!query.exec()) {
+            qDebug() << "Ошибка поиска:" << query.lastError().text();
+            return result;
+        }
+
+        while (query.next()) {
+            qint64 rowid = query.value(0).toLongLong();
+            SearchResult row;
+            row.kind = SearchResult::Kind(rowid % SearchResult::SearchKindCount);
+            row.id = int(rowid / SearchResult::SearchKindCount);
+            row.title = query.value(1).toString();
+            result.append(row);
+        }
+    }
+
+    for (SearchResult &row : result) {
+        int teamId = -1;
+
+        switch (row.kind) {
+        case SearchResult::SearchTeam:
+            teamId = row.id;
+            row.subtitle = "Команда";
+            break;
+        case SearchResult::SearchPlayer: {
+            StatementCache::Run query(statements, "SELECT team_id FROM players WHERE id = ?");
+            query.bind(0, row.id);
+            if (query.exec() && query.next()) {
+                teamId = query.value(0).toInt();
+            }
+            QString team = names->teamName(teamId);
+            row.subtitle = team.isEmpty() ? QString("Игрок") : QString("Игрок, %1").arg(team);
+            break;
+        }
+        case SearchResult::SearchTournament: {
+            StatementCache::Run query(statements,
+                "SELECT s.name, t.season FROM tournaments t JOIN sports s ON s.id = t.sport_id WHERE t.id = ?");
+            query.bind(0, row.id);
+            if (query.exec() && query.next()) {
+                row.subtitle = QString("Турнир, %1 %2").arg(query.value(0).toString(),
+                                                            query.value(1).toString()).trimmed();
+            }
+            row.tournamentId = row.id;
+            row.tournamentName = row.title;
+            break;
+        }
+        case SearchResult::SearchMatch: {
+            StatementCache::Run query(statements,
+                "SELECT tournament_id, round, date, team1_id, team2_id FROM matches WHERE id = ?");
+            query.bind(0, row.id);
+            if (query.exec() && query.next()) {
+                // Найденный текст (стадион и судья) уходит в подзаголовок
+                QString date = QDate::fromString(query.value(2).toString().left(10), Qt::ISODate)
+                                   .toString("dd.MM.yyyy");
+                row.subtitle = QString("%1, %2").arg(date, row.title);
+                row.title = QString("%1 — %2").arg(names->teamName(query.value(3).toInt()),
+                                                  names->teamName(query.value(4).toInt()));
+                row.tournamentId = query.value(0).toInt();
+                row.round = query.value(1).toInt();
+            }
+            break;
+        }
+        case SearchResult::SearchKindCount:
+            break;
+        }
+
+        // Команда и игрок ведут в турнир последнего домашнего матча команды
+        if (teamId != -1) {
+            StatementCache::Run query(statements,
+                "SELECT tournament_id FROM matches WHERE team1_id = ? ORDER BY date DESC LIMIT 1");
+            query.bind(0, teamId);
+            if (query.exec() && query.next()) {
+                row.tournamentId = query.value(0).toInt();
+            }
+        }
+
+        if (row.tournamentId != -1 && row.tournamentName.isEmpty()) {
+            StatementCache::Run query(statements, "SELECT name FROM tournaments WHERE id = ?");
+            query.bind(0, row.tournamentId);
+            if (query.exec() && query.next()) {
+                row.tournamentName = query.value(0).toString();
+            }
+        }
+    }
+    return result;
+}
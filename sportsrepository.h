@@ -0,0 +1,74 @@
+#ifndef SPORTSREPOSITORY_H
+#define SPORTSREPOSITORY_H
+
+#include "datatypes.h"
+#include "statementcache.h"
+#include "sportrules.h"
+
+#include <QSqlDatabase>
+#include <memory>
+
+class TeamDictionary;
+
+// Все SQL-запросы приложения. Работает с переданным соединением и должен
+// использоваться только в том потоке, где это соединение было открыто.
+// Запросы оперируют id команд и игроков, а имена подставляются из
+// общего справочника без обращения к SQL.
+class SportsRepository
+{
+public:
+    explicit SportsRepository(const QSqlDatabase &db);
+
+    QSqlDatabase database() const { return db; }
+
+    std::shared_ptr<const TeamDictionary> dictionary() const { return names; }
+    void setDictionary(const std::shared_ptr<const TeamDictionary> &dictionary);
+
+    // Счётчики и время выполнения подготовленных запросов этого соединения
+    QVector<StatementCache::Stats> statementStats() const { return statements.stats(); }
+    void logStatementStats(const QString &connectionName) const;
+
+    QVector<SportRow> sports();
+    QVector<TournamentRow> tournaments(int sportId);
+    QVector<RoundInfo> rounds(int tournamentId);
+    QVector<MatchListRow> matchesPage(int tournamentId, int round,
+                                      const MatchPageCursor &after, int limit);
+    QVector<StandingRow> standings(int tournamentId);
+    // Правила турнирной таблицы по виду спорта турнира
+    SportKind sportKind(int tournamentId);
+
+    bool matchHeader(int matchId, MatchHeader *header);
+    QVector<StatRow> matchStats(const MatchHeader &header);
+    QVector<LineupEntry> lineups(const MatchHeader &header);
+    QVector<EventRow> events(const MatchHeader &header);
+    QVector<HistoryRow> recentMatches(int teamId, const QDate &beforeDate);
+    QVector<HistoryRow> headToHead(int team1Id, int team2Id, const QDate &beforeDate);
+
+    // Итоги всех игроков турнира из player_tournament_totals
+    QVector<LeaderRow> playerTotals(int tournamentId);
+
+    // Числовые значения match_stats всех матчей турнира по показателям (StatCatalogue)
+    QVector<TeamStatSamples> teamStatSamples(int tournamentId);
+
+    // PRAGMA data_version: меняется, когда БД изменило другое соединение
+    qint64 dataVersion();
+
+    // Полнотекстовый поиск по search_index: слова запроса ищутся как префиксы
+    QVector<SearchResult> search(const QString &text, int limit);
+    static QString searchExpression(const QString &text);
+
+    static MatchHeader headerFor(const MatchListRow &row);
+
+    // Тексты запросов страницы матча, по которым проверяется использование индексов
+    static const char *matchStatsSql();
+    static const char *lineupsSql();
+    static const char *recentMatchesSql();
+    static const char *headToHeadSql();
+
+private:
+    QSqlDatabase db;
+    std::shared_ptr<const TeamDictionary> names;
+    StatementCache statements;
+};
+
+#endif // SPORTSREPOSITORY_H
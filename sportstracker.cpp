@@ -1,4 +1,17 @@
 #include "sportstracker.h"
+#include "dataworker.h"
+#include "sportsrepository.h"
+#include "standingsmodel.h"
+#include "matchlistmodel.h"
+#include "matcheventsmodel.h"
+#include "historymodel.h"
+#include "searchresultsmodel.h"
+#include "leadersmodel.h"
+#include "matchstatsmodel.h"
+#include "lineupsmodel.h"
+#include "teamstatsmodel.h"
+#include "itemdelegates.h"
+#include "tracing.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
@@ -11,24 +24,118 @@
 #include <QSqlQuery>
 #include <QTabWidget>
 #include <QDate>
-#include <QFont>
 #include <QScrollBar>
 #include <QComboBox>
 #include <QPushButton>
 #include <QButtonGroup>
+#include <QMenuBar>
+#include <QMenu>
+#include <QAction>
+#include <QFileDialog>
+#include <QDateTime>
+
+namespace {
+
+// Панели страницы матча; страница попадает в кэш, когда пришли все
+enum DetailsPart {
+    StatsPart = 0x01,
+    LineupsPart = 0x02,
+    EventsPart = 0x04,
+    Team1RecentPart = 0x08,
+    Team2RecentPart = 0x10,
+    HeadToHeadPart = 0x20,
+    AllDetailsParts = 0x3f
+};
+
+// Размер страницы списка матчей; тур обычно помещается в одну страницу
+const int MatchPageSize = 100;
+
+// Число прогонов сезона для вероятностей в турнирной таблице
+const int SeasonSimulations = 200000;
+
+// Поиск начинается после паузы в наборе и с двух символов (префиксный индекс FTS5)
+const int SearchDebounceMs = 200;
+const int SearchMinLength = 2;
+const int SearchLimit = 50;
+
+// Длина таблицы лидеров турнира
+const int LeadersCount = 20;
+
+QString shortDate(const QString &date)
+{
+    return QDateTime::fromString(date, "yyyy-MM-dd HH:mm:ss").toString("dd.MM.yyyy");
+}
+
+// У нераскрывавшегося вида спорта единственный ребёнок — пустая заглушка
+bool hasTournamentItems(const QTreeWidgetItem *sportItem)
+{
+    return sportItem->childCount() > 0
+           && !(sportItem->childCount() == 1 && sportItem->child(0)->text(0).isEmpty());
+}
+
+QVector<TournamentRow> tournamentItems(const QTreeWidgetItem *sportItem)
+{
+    QVector<TournamentRow> rows;
+    rows.reserve(sportItem->childCount());
+    for (int i = 0; i < sportItem->childCount(); ++i) {
+        TournamentRow row;
+        row.id = sportItem->child(i)->data(0, Qt::UserRole).toInt();
+        row.sportId = sportItem->data(0, Qt::UserRole).toInt();
+        row.name = sportItem->child(i)->text(0);
+        rows.append(row);
+    }
+    return rows;
+}
+
+// Подзаголовок раздела страницы; шрифт задаёт тема по objectName
+QLabel *sectionTitle(const QString &text)
+{
+    QLabel *label = new QLabel(text);
+    label->setObjectName("sectionTitle");
+    return label;
+}
+
+void addTournamentItems(QTreeWidgetItem *sportItem, const QVector<TournamentRow> &rows)
+{
+    for (const TournamentRow &tournament : rows) {
+        QTreeWidgetItem *tournamentItem = new QTreeWidgetItem(sportItem);
+        tournamentItem->setText(0, tournament.name);
+        tournamentItem->setData(0, Qt::UserRole, tournament.id);
+    }
+}
+
+} // namespace
 
 SportsTracker::SportsTracker(QWidget *parent)
     : QMainWindow(parent),
       stackedWidget(new QStackedWidget(this)),
       sportsTree(new QTreeWidget()),
-      matchesList(new QListWidget()),
-      standingsTable(new QTableWidget()),
-      statsTable(new QTableWidget()),
-      lineupsTable(new QTableWidget()),
-      scorersTable(new QTableWidget()),
-      team1RecentMatches(new QTableWidget()),
-      team2RecentMatches(new QTableWidget()),
-      headToHeadMatches(new QTableWidget()),
+      matchesList(new QListView()),
+      standingsTable(new QTableView()),
+      statsTable(new QTableView()),
+      lineupsTable(new QTableView()),
+      scorersTable(new QTableView()),
+      team1RecentMatches(new QTableView()),
+      team2RecentMatches(new QTableView()),
+      headToHeadMatches(new QTableView()),
+      searchEdit(new QLineEdit()),
+      searchResults(new QListView()),
+      leadersTable(new QTableView()),
+      leadersCategory(new QComboBox()),
+      teamStatsTable(new QTableView()),
+      teamStatsAggregate(new QComboBox()),
+      tournamentTabs(new QTabWidget()),
+      matchesModel(new MatchListModel(this)),
+      standingsModel(new StandingsModel(this)),
+      scorersModel(new MatchEventsModel(this)),
+      team1RecentModel(new HistoryModel(this)),
+      team2RecentModel(new HistoryModel(this)),
+      headToHeadModel(new HistoryModel(this)),
+      searchModel(new SearchResultsModel(this)),
+      leadersModel(new LeadersModel(this)),
+      statsModel(new MatchStatsModel(this)),
+      lineupsModel(new LineupsModel(this)),
+      teamStatsModel(new TeamStatsModel(this)),
       matchTitle(new QLabel()),
       backButton1(new QPushButton("Назад к турнирам")),
       backButton2(new QPushButton("Назад к матчам")),
@@ -40,76 +147,208 @@ SportsTracker::SportsTracker(QWidget *parent)
       currentMatchId(-1),
       currentTournamentName(""),
       currentRound(-1),
+      pendingRound(-1),
       currentRoundPage(0),
       roundsPerPage(5),
       roundsPopup(nullptr),
       roundButton(nullptr),
       roundsGroup(nullptr),
-      db(QSqlDatabase::addDatabase("QSQLITE"))
+      roundsNavigation(nullptr),
+      prevRoundsButton(nullptr),
+      nextRoundsButton(nullptr),
+      dataWorker(nullptr),
+      roundsTicket(0),
+      matchesTicket(0),
+      standingsTicket(0),
+      projectionTicket(0),
+      matchDetailsTicket(0),
+      searchTicket(0),
+      leadersTicket(0),
+      teamStatsTicket(0),
+      liveTicket(0),
+      pendingParts(0)
 {
     setWindowTitle("SportsTracker - Анализ спортивных результатов");
     resize(1400, 800);
-    setStyleSheet("QMainWindow { background-color: #f5f5f5; }");
-
-    if (!initializeDatabase()) {
-        QMessageBox::critical(this, "Ошибка", "Не удалось подключиться к базе данных");
-        return;
-    }
 
+    // SPORTSTRACKER_TRACE=<файл> включает трассировку с запуска и выгрузку при выходе
+    tracePath = Trace::pathFromEnvironment();
+
+    initializeDatabase();
+
+    // Все запросы выполняются в отдельном потоке со своим соединением
+    dataWorker = new DataWorker(databaseConfig);
+    dataWorker->moveToThread(&dataThread);
+    connect(&dataThread, &QThread::started, dataWorker, &DataWorker::openDatabase);
+    connect(dataWorker, &DataWorker::databaseOpened, this, &SportsTracker::onDatabaseOpened);
+    connect(dataWorker, &DataWorker::sportsLoaded, this, &SportsTracker::onSportsLoaded);
+    connect(dataWorker, &DataWorker::tournamentsLoaded, this, &SportsTracker::onTournamentsLoaded);
+    connect(dataWorker, &DataWorker::roundsLoaded, this, &SportsTracker::onRoundsLoaded);
+    connect(dataWorker, &DataWorker::matchPageLoaded, this, &SportsTracker::onMatchPageLoaded);
+    connect(dataWorker, &DataWorker::standingsLoaded, this, &SportsTracker::onStandingsLoaded);
+    connect(dataWorker, &DataWorker::seasonProjectionLoaded, this, &SportsTracker::onSeasonProjectionLoaded);
+    connect(dataWorker, &DataWorker::matchStatsLoaded, this, &SportsTracker::onMatchStatsLoaded);
+    connect(dataWorker, &DataWorker::lineupsLoaded, this, &SportsTracker::onLineupsLoaded);
+    connect(dataWorker, &DataWorker::eventsLoaded, this, &SportsTracker::onEventsLoaded);
+    connect(dataWorker, &DataWorker::recentMatchesLoaded, this, &SportsTracker::onRecentMatchesLoaded);
+    connect(dataWorker, &DataWorker::headToHeadLoaded, this, &SportsTracker::onHeadToHeadLoaded);
+    connect(dataWorker, &DataWorker::matchDetailsPrefetched, this, &SportsTracker::onMatchDetailsPrefetched);
+    connect(dataWorker, &DataWorker::roundPrefetched, this, &SportsTracker::onRoundPrefetched);
+    connect(dataWorker, &DataWorker::diagnosticsLoaded, this, &SportsTracker::onDiagnosticsLoaded);
+    connect(dataWorker, &DataWorker::searchResultsLoaded, this, &SportsTracker::onSearchResultsLoaded);
+    connect(dataWorker, &DataWorker::leadersLoaded, this, &SportsTracker::onLeadersLoaded);
+    connect(dataWorker, &DataWorker::teamStatsLoaded, this, &SportsTracker::onTeamStatsLoaded);
+    connect(dataWorker, &DataWorker::databaseChanged, this, &SportsTracker::onDatabaseChanged);
+    connect(dataWorker, &DataWorker::liveRefreshed, this, &SportsTracker::onLiveRefreshed);
+
+    // Окно сразу строится из снимка прошлого сеанса, а БД открывается и
+    // проверяется в потоке воркера; свежие данные придут после databaseOpened
     setupUI();
-    loadSports();
+    restoreSnapshot();
+    dataThread.start();
 }
 
 SportsTracker::~SportsTracker()
 {
-    if (db.isOpen()) {
-        db.close();
+    saveSnapshot();
+
+    if (dataWorker) {
+        QMetaObject::invokeMethod(dataWorker, "closeDatabase", Qt::BlockingQueuedConnection);
+        dataThread.quit();
+        dataThread.wait();
+        delete dataWorker;
+    }
+
+    if (!tracePath.isEmpty()) {
+        Trace::dumpChromeTrace(tracePath);
     }
 }
 
-bool SportsTracker::initializeDatabase()
+void SportsTracker::initializeDatabase()
 {
     QString dbPath = QDir::homePath() + "/database/sports.db";
 
     if (!QDir().mkpath(QDir::homePath() + "/database")) {
         qDebug() << "Не удалось создать директорию для БД";
-        return false;
     }
 
-    db.setDatabaseName(dbPath);
+    // SPORTSTRACKER_DB_* задают режим только чтения, mmap и размер кеша;
+    // само соединение открывает воркер
+    databaseConfig = DatabaseConfig::fromEnvironment(dbPath);
+    snapshotPath = NavigationSnapshot::pathFor(dbPath);
+}
 
-    if (!db.open()) {
-        qDebug() << "Не удалось открыть БД:" << db.lastError().text();
-        return false;
+void SportsTracker::onDatabaseOpened(bool ok, const QString &error)
+{
+    TRACE_SCOPE("SportsTracker::onDatabaseOpened");
+    if (!ok) {
+        QMessageBox::critical(this, "Ошибка", error);
+        return;
     }
 
-    QStringList tables = db.tables();
-    QStringList requiredTables = {"sports", "tournaments", "teams", "matches", "standings",
-                                "players", "match_lineups", "match_events", "match_stats"};
+    // Показанное из снимка заменяется, только если в БД что-то изменилось
+    loadSports();
+    if (currentTournamentId != -1) {
+        roundsTicket = dataWorker->requestRounds(currentTournamentId);
+        standingsTicket = dataWorker->requestStandings(currentTournamentId);
+    }
+}
 
-    for (const QString &table : requiredTables) {
-        if (!tables.contains(table)) {
-            qDebug() << "Таблица" << table << "не найдена в БД";
-            QMessageBox::warning(this, "Ошибка",
-                QString("Таблица %1 не найдена в базе данных").arg(table));
-            return false;
+void SportsTracker::restoreSnapshot()
+{
+    TraceScope trace("SportsTracker::restoreSnapshot");
+    NavigationSnapshot snapshot;
+    if (!snapshot.load(snapshotPath) || snapshot.isEmpty()) return;
+
+    for (const SportRow &sport : snapshot.sports) {
+        QTreeWidgetItem *sportItem = new QTreeWidgetItem(sportsTree);
+        sportItem->setText(0, sport.name);
+        sportItem->setData(0, Qt::UserRole, sport.id);
+
+        auto tournaments = snapshot.tournaments.constFind(sport.id);
+        if (tournaments != snapshot.tournaments.constEnd()) {
+            addTournamentItems(sportItem, tournaments.value());
+        } else {
+            new QTreeWidgetItem(sportItem); // Пустой child для отображения стрелки раскрытия
         }
+        sportItem->setExpanded(snapshot.expandedSports.contains(sport.id));
+    }
+    trace.setRows(sportsTree->topLevelItemCount());
+
+    if (snapshot.tournamentId == -1) return;
+
+    currentTournamentId = snapshot.tournamentId;
+    currentTournamentName = snapshot.tournamentName;
+    currentRoundPage = 0;
+    allRounds = snapshot.rounds;
+    currentRound = snapshot.round;
+    roundButton->setText(currentRound != -1 ? QString("Тур %1").arg(currentRound) : "Все туры");
+    standingsModel->setRows(snapshot.standings);
+    resizeStandingsColumns();
+    trace.setRows(sportsTree->topLevelItemCount() + standingsModel->rowCount());
+
+    stackedWidget->setCurrentIndex(1);
+    leftPanelStack->setCurrentIndex(0);
+    setWindowTitle(currentTournamentName);
+}
+
+void SportsTracker::saveSnapshot()
+{
+    if (sportsTree->topLevelItemCount() == 0) return;
+
+    NavigationSnapshot snapshot;
+    for (int i = 0; i < sportsTree->topLevelItemCount(); ++i) {
+        QTreeWidgetItem *sportItem = sportsTree->topLevelItem(i);
+        SportRow sport;
+        sport.id = sportItem->data(0, Qt::UserRole).toInt();
+        sport.name = sportItem->text(0);
+        snapshot.sports.append(sport);
+
+        if (hasTournamentItems(sportItem)) {
+            snapshot.tournaments.insert(sport.id, tournamentItems(sportItem));
+        }
+        if (sportItem->isExpanded()) {
+            snapshot.expandedSports.append(sport.id);
+        }
+    }
+
+    if (currentTournamentId != -1) {
+        snapshot.tournamentId = currentTournamentId;
+        snapshot.tournamentName = currentTournamentName;
+        snapshot.round = currentRound;
+        snapshot.rounds = allRounds;
+        snapshot.standings = standingsModel->standings();
     }
 
-    return true;
+    snapshot.save(snapshotPath);
 }
 
 void SportsTracker::setupUI()
 {
+    // Меню диагностики: запись трассировки и её сохранение для chrome://tracing
+    QMenu *debugMenu = menuBar()->addMenu("Отладка");
+    QAction *traceAction = debugMenu->addAction("Записывать трассировку");
+    traceAction->setCheckable(true);
+    traceAction->setChecked(Trace::enabled());
+    connect(traceAction, &QAction::toggled, this, [](bool checked) {
+        Trace::setEnabled(checked);
+    });
+    QAction *saveTraceAction = debugMenu->addAction("Сохранить трассировку...");
+    connect(saveTraceAction, &QAction::triggered, this, &SportsTracker::saveTrace);
+    debugMenu->addSeparator();
+    QAction *diagnosticsAction = debugMenu->addAction("Параметры БД");
+    connect(diagnosticsAction, &QAction::triggered, this, &SportsTracker::showDatabaseDiagnostics);
+
+    // Оформление задаёт AppTheme при запуске; здесь виджетам назначаются только имена
     QWidget *centralWidget = new QWidget(this);
-    centralWidget->setStyleSheet("background-color: #f5f5f5;");
+    centralWidget->setObjectName("centralWidget");
     setCentralWidget(centralWidget);
 
     QVBoxLayout *mainLayout = new QVBoxLayout(centralWidget);
     mainLayout->setContentsMargins(10, 10, 10, 10);
     mainLayout->setSpacing(15);
 
-    stackedWidget->setStyleSheet("QStackedWidget { background: white; border-radius: 8px; }");
+    stackedWidget->setObjectName("pages");
     mainLayout->addWidget(stackedWidget);
 
     // Страница выбора турнира
@@ -119,15 +358,34 @@ void SportsTracker::setupUI()
     selectionLayout->setSpacing(20);
 
     sportsTree->setHeaderHidden(true);
-    sportsTree->setStyleSheet(
-        "QTreeWidget { font-size: 16px; background: white; border: 1px solid #ddd; "
-        "border-radius: 6px; padding: 5px; }"
-        "QTreeWidget::item { height: 30px; padding: 5px; }"
-        "QTreeWidget::item:hover { background: #e6f2ff; }"
-        "QTreeWidget::item:selected { background: #cce0ff; color: black; }");
+    sportsTree->setObjectName("sportsTree");
     sportsTree->setColumnCount(1);
     connect(sportsTree, &QTreeWidget::itemClicked, this, &SportsTracker::onTournamentClicked);
+    connect(sportsTree, &QTreeWidget::itemExpanded, this, &SportsTracker::loadTournaments);
     selectionLayout->addWidget(sportsTree, 1);
+
+    // Поиск по командам, игрокам, турнирам, стадионам и судьям
+    QWidget *searchPanel = new QWidget();
+    QVBoxLayout *searchLayout = new QVBoxLayout(searchPanel);
+    searchLayout->setContentsMargins(0, 0, 0, 0);
+    searchLayout->setSpacing(10);
+
+    searchEdit->setPlaceholderText("Поиск команд, игроков, турниров, стадионов и судей");
+    searchEdit->setClearButtonEnabled(true);
+    searchEdit->setObjectName("searchEdit");
+    searchLayout->addWidget(searchEdit);
+
+    searchResults->setModel(searchModel);
+    searchResults->setObjectName("searchResults");
+    searchLayout->addWidget(searchResults, 1);
+
+    searchTimer.setSingleShot(true);
+    searchTimer.setInterval(SearchDebounceMs);
+    connect(searchEdit, &QLineEdit::textChanged, this, [this]() { searchTimer.start(); });
+    connect(&searchTimer, &QTimer::timeout, this, &SportsTracker::runSearch);
+    connect(searchResults, &QListView::clicked, this, &SportsTracker::onSearchResultActivated);
+    selectionLayout->addWidget(searchPanel, 1);
+
     stackedWidget->addWidget(selectionPage);
 
     // Страница турнира
@@ -137,7 +395,7 @@ void SportsTracker::setupUI()
     tournamentLayout->setSpacing(20);
 
     // Левая панель (матчи/статистика)
-    leftPanelStack->setStyleSheet("QStackedWidget { background: transparent; }");
+    leftPanelStack->setObjectName("leftPanel");
 
     // Страница списка матчей
     QWidget *matchesPage = new QWidget();
@@ -153,30 +411,23 @@ void SportsTracker::setupUI()
     roundSelectorLayout->addWidget(roundLabel);
 
     roundButton = new QPushButton("Выбрать тур");
-    roundButton->setStyleSheet(
-        "QPushButton { padding: 5px 10px; background: #4a90e2; color: white; "
-        "border-radius: 4px; }"
-        "QPushButton:hover { background: #3a7bc8; }");
+    roundButton->setObjectName("roundButton");
     connect(roundButton, &QPushButton::clicked, this, &SportsTracker::showRoundSelectionPopup);
     roundSelectorLayout->addWidget(roundButton);
     roundSelectorLayout->addStretch();
 
     matchesLayout->addWidget(roundSelectorWidget);
 
-    matchesList->setStyleSheet(
-        "QListWidget { font-size: 14px; background: white; border: 1px solid #ddd; "
-        "border-radius: 6px; }"
-        "QListWidget::item { padding: 8px; border-bottom: 1px solid #eee; }"
-        "QListWidget::item:hover { background: #e6f2ff; }"
-        "QListWidget::item:selected { background: #cce0ff; }");
+    matchesList->setObjectName("matchesList");
     matchesList->setAlternatingRowColors(false);
-    connect(matchesList, &QListWidget::itemClicked, this, &SportsTracker::showMatchStats);
+    matchesList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    matchesList->setUniformItemSizes(true);
+    matchesList->setModel(matchesModel);
+    connect(matchesModel, &MatchListModel::fetchMoreRequested, this, &SportsTracker::fetchMatchPage);
+    connect(matchesList, &QListView::clicked, this, &SportsTracker::showMatchStats);
     matchesLayout->addWidget(matchesList, 1);
 
-    backButton1->setStyleSheet(
-        "QPushButton { font-size: 14px; padding: 8px 16px; background: #4a90e2; "
-        "color: white; border-radius: 4px; border: none; }"
-        "QPushButton:hover { background: #3a7bc8; }");
+    backButton1->setObjectName("backButton");
     connect(backButton1, &QPushButton::clicked, [this]() { stackedWidget->setCurrentIndex(0); });
     matchesLayout->addWidget(backButton1, 0, Qt::AlignRight);
     leftPanelStack->addWidget(matchesPage);
@@ -187,52 +438,49 @@ void SportsTracker::setupUI()
     statsPageLayout->setContentsMargins(0, 0, 0, 0);
     statsPageLayout->setSpacing(15);
 
-    matchTitle->setStyleSheet(
-        "QLabel { font-size: 20px; font-weight: bold; color: #333; padding: 10px 0; }");
+    matchTitle->setObjectName("matchTitle");
     matchTitle->setAlignment(Qt::AlignCenter);
     statsPageLayout->addWidget(matchTitle);
 
-    statsTabs->setStyleSheet(
-        "QTabWidget::pane { border: 1px solid #ddd; border-radius: 6px; background: white; }"
-        "QTabBar::tab { padding: 8px 16px; background: #f0f0f0; border: 1px solid #ddd; "
-        "border-bottom: none; border-top-left-radius: 4px; border-top-right-radius: 4px; }"
-        "QTabBar::tab:selected { background: white; border-bottom: 1px solid white; "
-        "margin-bottom: -1px; }");
-
     // Вкладка обзора матча
     QVBoxLayout *overviewLayout = new QVBoxLayout(matchOverviewTab);
     overviewLayout->setContentsMargins(10, 10, 10, 10);
     overviewLayout->setSpacing(15);
 
-    QString tableStyle =
-        "QTableWidget { font-size: 14px; background: white; border: 1px solid #ddd; "
-        "border-radius: 6px; gridline-color: #eee; }"
-        "QHeaderView::section { background-color: #4a90e2; color: white; padding: 6px; "
-        "font-weight: bold; border: none; }"
-        "QTableWidget::item { padding: 5px; }"
-        "QTableWidget::item:selected { background: #cce0ff; }";
-
-    statsTable->setStyleSheet(tableStyle);
+    // Ширина столбцов статистики и составов постоянна и задаётся один раз
+    statsTable->setObjectName("matchStatsTable");
     statsTable->verticalHeader()->setVisible(false);
+    statsTable->horizontalHeader()->setVisible(false);
+    statsTable->setShowGrid(false);
     statsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     statsTable->setAlternatingRowColors(false);
-    overviewLayout->addWidget(new QLabel("<b style='font-size: 16px;'>Основная статистика матча</b>"));
+    statsTable->setModel(statsModel);
+    statsTable->setItemDelegate(new MatchStatsDelegate(statsTable));
+    statsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    statsTable->setColumnWidth(MatchStatsModel::Team1Column, 175);
+    statsTable->setColumnWidth(MatchStatsModel::NameColumn, 250);
+    statsTable->setColumnWidth(MatchStatsModel::Team2Column, 150);
+    overviewLayout->addWidget(sectionTitle("Основная статистика матча"));
     overviewLayout->addWidget(statsTable);
 
-    lineupsTable->setStyleSheet(tableStyle +
-        "QTableView::item { border-right: 1px solid #ddd; }"
-        "QTableView::item:nth-child(4) { border-right: 2px solid #aaa; }");
+    lineupsTable->setObjectName("lineupsTable");
     lineupsTable->verticalHeader()->setVisible(false);
+    lineupsTable->horizontalHeader()->setVisible(false);
+    lineupsTable->setShowGrid(false);
     lineupsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     lineupsTable->setAlternatingRowColors(false);
-    overviewLayout->addWidget(new QLabel("<b style='font-size: 16px;'>Составы команд</b>"));
+    lineupsTable->setModel(lineupsModel);
+    lineupsTable->setItemDelegate(new LineupDelegate(lineupsTable));
+    lineupsTable->setColumnWidth(LineupsModel::Team1Column, 270);
+    lineupsTable->setColumnWidth(LineupsModel::Team2Column, 270);
+    overviewLayout->addWidget(sectionTitle("Составы команд"));
     overviewLayout->addWidget(lineupsTable);
 
-    scorersTable->setStyleSheet(tableStyle);
     scorersTable->verticalHeader()->setVisible(false);
     scorersTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     scorersTable->setAlternatingRowColors(false);
-    overviewLayout->addWidget(new QLabel("<b style='font-size: 16px;'>Ход матча</b>"));
+    scorersTable->setModel(scorersModel);
+    overviewLayout->addWidget(sectionTitle("Ход матча"));
     overviewLayout->addWidget(scorersTable);
 
     statsTabs->addTab(matchOverviewTab, "Обзор матча");
@@ -242,41 +490,39 @@ void SportsTracker::setupUI()
     historyLayout->setContentsMargins(10, 10, 10, 10);
     historyLayout->setSpacing(15);
 
-    QLabel *recentMatchesLabel = new QLabel("<b style='font-size: 16px;'>Последние матчи команд</b>");
-    historyLayout->addWidget(recentMatchesLabel);
+    historyLayout->addWidget(sectionTitle("Последние матчи команд"));
 
     QWidget *recentMatchesWidget = new QWidget();
     QHBoxLayout *recentMatchesLayout = new QHBoxLayout(recentMatchesWidget);
     recentMatchesLayout->setContentsMargins(0, 0, 0, 0);
     recentMatchesLayout->setSpacing(15);
 
-    team1RecentMatches->setStyleSheet(tableStyle);
     team1RecentMatches->verticalHeader()->setVisible(false);
     team1RecentMatches->setEditTriggers(QAbstractItemView::NoEditTriggers);
     team1RecentMatches->setAlternatingRowColors(false);
+    team1RecentMatches->setModel(team1RecentModel);
     recentMatchesLayout->addWidget(team1RecentMatches);
 
-    team2RecentMatches->setStyleSheet(tableStyle);
     team2RecentMatches->verticalHeader()->setVisible(false);
     team2RecentMatches->setEditTriggers(QAbstractItemView::NoEditTriggers);
     team2RecentMatches->setAlternatingRowColors(false);
+    team2RecentMatches->setModel(team2RecentModel);
     recentMatchesLayout->addWidget(team2RecentMatches);
 
     historyLayout->addWidget(recentMatchesWidget);
 
-    QLabel *h2hLabel = new QLabel("<b style='font-size: 16px;'>История очных встреч</b>");
-    historyLayout->addWidget(h2hLabel);
+    historyLayout->addWidget(sectionTitle("История очных встреч"));
 
-    headToHeadMatches->setStyleSheet(tableStyle);
     headToHeadMatches->verticalHeader()->setVisible(false);
     headToHeadMatches->setEditTriggers(QAbstractItemView::NoEditTriggers);
     headToHeadMatches->setAlternatingRowColors(false);
+    headToHeadMatches->setModel(headToHeadModel);
     historyLayout->addWidget(headToHeadMatches);
 
     statsTabs->addTab(historyTab, "История");
     statsPageLayout->addWidget(statsTabs, 1);
 
-    backButton2->setStyleSheet(backButton1->styleSheet());
+    backButton2->setObjectName("backButton");
     connect(backButton2, &QPushButton::clicked, this, &SportsTracker::showMatchesList);
     statsPageLayout->addWidget(backButton2, 0, Qt::AlignRight);
     leftPanelStack->addWidget(statsPage);
@@ -289,15 +535,17 @@ void SportsTracker::setupUI()
     standingsLayout->setContentsMargins(0, 0, 0, 0);
     standingsLayout->setSpacing(10);
 
-    QLabel *standingsLabel = new QLabel("<b style='font-size: 18px;'>Турнирная таблица</b>");
+    QLabel *standingsLabel = new QLabel("Турнирная таблица");
+    standingsLabel->setObjectName("panelTitle");
     standingsLabel->setAlignment(Qt::AlignCenter);
     standingsLayout->addWidget(standingsLabel);
 
-    standingsTable->setStyleSheet(tableStyle);
     standingsTable->verticalHeader()->setVisible(false);
     standingsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     standingsTable->setAlternatingRowColors(false);
     standingsTable->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    standingsTable->setModel(standingsModel);
+    standingsTable->setItemDelegate(new StandingsDelegate(standingsTable));
 
     QHeaderView* header = standingsTable->horizontalHeader();
     header->setSectionResizeMode(QHeaderView::Interactive);
@@ -307,51 +555,135 @@ void SportsTracker::setupUI()
     standingsTable->verticalScrollBar()->setSingleStep(20);
 
     standingsLayout->addWidget(standingsTable);
-    tournamentLayout->addWidget(standingsWidget, 1);
+    tournamentTabs->addTab(standingsWidget, "Таблица");
+
+    // Вкладка лидеров: итоги игроков из агрегатной таблицы, лучшие отбираются воркером
+    QWidget *leadersWidget = new QWidget();
+    QVBoxLayout *leadersLayout = new QVBoxLayout(leadersWidget);
+    leadersLayout->setContentsMargins(10, 10, 10, 10);
+    leadersLayout->setSpacing(10);
+
+    for (int category = 0; category < Leaderboard::CategoryCount; ++category) {
+        leadersCategory->addItem(Leaderboard::categoryName(Leaderboard::Category(category)), category);
+    }
+    connect(leadersCategory, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &SportsTracker::loadLeaders);
+    leadersLayout->addWidget(leadersCategory, 0, Qt::AlignLeft);
+
+    leadersTable->verticalHeader()->setVisible(false);
+    leadersTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    leadersTable->setAlternatingRowColors(false);
+    leadersTable->setModel(leadersModel);
+    leadersTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    leadersTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    leadersLayout->addWidget(leadersTable);
+
+    tournamentTabs->addTab(leadersWidget, "Лидеры");
+
+    // Вкладка статистики команд: сезонные суммы, средние и процентили из match_stats
+    QWidget *teamStatsWidget = new QWidget();
+    QVBoxLayout *teamStatsLayout = new QVBoxLayout(teamStatsWidget);
+    teamStatsLayout->setContentsMargins(10, 10, 10, 10);
+    teamStatsLayout->setSpacing(10);
+
+    teamStatsAggregate->addItem("Сумма", TeamStatsModel::Sum);
+    teamStatsAggregate->addItem("Среднее за матч", TeamStatsModel::Mean);
+    teamStatsAggregate->addItem("Процентиль", TeamStatsModel::Percentile);
+    teamStatsAggregate->setCurrentIndex(1);
+    connect(teamStatsAggregate, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        teamStatsModel->setAggregate(TeamStatsModel::Aggregate(teamStatsAggregate->currentData().toInt()));
+    });
+    teamStatsLayout->addWidget(teamStatsAggregate, 0, Qt::AlignLeft);
+
+    teamStatsTable->verticalHeader()->setVisible(false);
+    teamStatsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    teamStatsTable->setAlternatingRowColors(false);
+    teamStatsTable->setModel(teamStatsModel);
+    teamStatsTable->setSortingEnabled(true);
+    teamStatsTable->sortByColumn(0, Qt::AscendingOrder);
+    teamStatsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    teamStatsLayout->addWidget(teamStatsTable);
+
+    tournamentTabs->addTab(teamStatsWidget, "Статистика команд");
+    // Лидеры и статистика команд загружаются, только когда их вкладка открыта
+    connect(tournamentTabs, &QTabWidget::currentChanged, this, &SportsTracker::loadLeaders);
+    connect(tournamentTabs, &QTabWidget::currentChanged, this, &SportsTracker::loadTeamStats);
+    tournamentLayout->addWidget(tournamentTabs, 1);
 
     stackedWidget->addWidget(tournamentPage);
 }
 
 void SportsTracker::loadSports()
 {
-    sportsTree->clear();
+    // Дерево не очищается: восстановленное из снимка остаётся до сверки с БД
+    dataWorker->requestSports();
+}
 
-    QSqlQuery query("SELECT id, name FROM sports ORDER BY name", db);
-    if (!query.exec()) {
-        qDebug() << "Ошибка загрузки видов спорта:" << query.lastError().text();
+void SportsTracker::onSportsLoaded(quint64 ticket, const QVector<SportRow> &rows)
+{
+    TraceScope trace("SportsTracker::onSportsLoaded");
+    Q_UNUSED(ticket);
+
+    QVector<SportRow> shown;
+    for (int i = 0; i < sportsTree->topLevelItemCount(); ++i) {
+        SportRow sport;
+        sport.id = sportsTree->topLevelItem(i)->data(0, Qt::UserRole).toInt();
+        sport.name = sportsTree->topLevelItem(i)->text(0);
+        shown.append(sport);
+    }
+
+    if (!rows.isEmpty() && rows == shown) {
+        // Виды спорта не изменились; уже показанные турниры сверяются отдельно
+        for (int i = 0; i < sportsTree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *sportItem = sportsTree->topLevelItem(i);
+            if (hasTournamentItems(sportItem)) {
+                dataWorker->requestTournaments(sportItem->data(0, Qt::UserRole).toInt());
+            }
+        }
         return;
     }
 
-    while (query.next()) {
+    sportsTree->clear();
+
+    for (const SportRow &sport : rows) {
         QTreeWidgetItem *sportItem = new QTreeWidgetItem(sportsTree);
-        sportItem->setText(0, query.value(1).toString());
-        sportItem->setData(0, Qt::UserRole, query.value(0).toInt());
+        sportItem->setText(0, sport.name);
+        sportItem->setData(0, Qt::UserRole, sport.id);
         new QTreeWidgetItem(sportItem); // Пустой child для отображения стрелки раскрытия
     }
-
-    connect(sportsTree, &QTreeWidget::itemExpanded, this, &SportsTracker::loadTournaments);
+    trace.setRows(sportsTree->topLevelItemCount());
 }
 
 void SportsTracker::loadTournaments(QTreeWidgetItem *sportItem)
 {
-    if (sportItem->childCount() == 1 && sportItem->child(0)->text(0).isEmpty()) {
-        delete sportItem->takeChild(0);
+    if (!hasTournamentItems(sportItem)) {
+        // Заглушка остаётся до прихода результата, чтобы повторное раскрытие не дублировало запрос
+        if (sportItem->child(0)->data(0, Qt::UserRole).toBool()) return;
+        sportItem->child(0)->setData(0, Qt::UserRole, true);
 
         int sportId = sportItem->data(0, Qt::UserRole).toInt();
-        QSqlQuery query(db);
-        query.prepare("SELECT id, name FROM tournaments WHERE sport_id = ? ORDER BY name");
-        query.addBindValue(sportId);
+        dataWorker->requestTournaments(sportId);
+    }
+}
 
-        if (!query.exec()) {
-            qDebug() << "Ошибка загрузки турниров:" << query.lastError().text();
-            return;
-        }
+void SportsTracker::onTournamentsLoaded(quint64 ticket, int sportId, const QVector<TournamentRow> &rows)
+{
+    TraceScope trace("SportsTracker::onTournamentsLoaded");
+    Q_UNUSED(ticket);
+
+    for (int i = 0; i < sportsTree->topLevelItemCount(); ++i) {
+        QTreeWidgetItem *sportItem = sportsTree->topLevelItem(i);
+        if (sportItem->data(0, Qt::UserRole).toInt() != sportId) continue;
 
-        while (query.next()) {
-            QTreeWidgetItem *tournamentItem = new QTreeWidgetItem(sportItem);
-            tournamentItem->setText(0, query.value(1).toString());
-            tournamentItem->setData(0, Qt::UserRole, query.value(0).toInt());
+        if (hasTournamentItems(sportItem)) {
+            // Турниры из снимка перестраиваются, только если список изменился
+            if (tournamentItems(sportItem) == rows) break;
         }
+        qDeleteAll(sportItem->takeChildren());
+
+        addTournamentItems(sportItem, rows);
+        trace.setRows(sportItem->childCount());
+        break;
     }
 }
 
@@ -367,6 +699,7 @@ void SportsTracker::onTournamentClicked(QTreeWidgetItem *item, int column)
 
 void SportsTracker::showTournamentPage(int tournamentId, const QString &tournamentName)
 {
+    TRACE_SCOPE("SportsTracker::showTournamentPage");
     currentTournamentId = tournamentId;
     currentTournamentName = tournamentName;
     currentRoundPage = 0;
@@ -380,134 +713,153 @@ void SportsTracker::loadMatchesAndStandings()
 {
     if (currentTournamentId == -1) return;
 
-    // Загрузка информации о турах
-    QSqlQuery roundsQuery(db);
-    roundsQuery.prepare("SELECT DISTINCT round FROM matches WHERE tournament_id = ? ORDER BY round");
-    roundsQuery.addBindValue(currentTournamentId);
-
+    // Загрузка информации о турах; матчи загружаются после выбора тура
+    matchesModel->clear();
+    roundMatches.clear();
     allRounds.clear();
-    if (roundsQuery.exec()) {
-        while (roundsQuery.next()) {
-            allRounds.append(roundsQuery.value(0).toInt());
-        }
-    } else {
-        qDebug() << "Ошибка загрузки туров:" << roundsQuery.lastError().text();
+    dataWorker->cancel(DataWorker::RoundPrefetchChannel);
+    roundsTicket = dataWorker->requestRounds(currentTournamentId);
+    loadStandings();
+    loadLeaders();
+    loadTeamStats();
+}
+
+void SportsTracker::onRoundsLoaded(quint64 ticket, int tournamentId, const QVector<RoundInfo> &rounds)
+{
+    TraceScope trace("SportsTracker::onRoundsLoaded");
+    if (ticket != roundsTicket || tournamentId != currentTournamentId) return;
+
+    // Те же туры, что восстановлены из снимка, оставляют выбранный тогда тур,
+    // а переход из поиска открывает тур найденного матча
+    bool sameRounds = !rounds.isEmpty() && rounds == allRounds;
+    allRounds = rounds;
+
+    bool hasPendingRound = false;
+    for (const RoundInfo &info : allRounds) {
+        hasPendingRound = hasPendingRound || info.round == pendingRound;
     }
+    if (hasPendingRound) {
+        currentRound = pendingRound;
+    }
+    pendingRound = -1;
 
-    // Загружаем последний тур по умолчанию
-    if (!allRounds.isEmpty()) {
-        currentRound = allRounds.last();
+    // Иначе загружаем последний тур по умолчанию
+    if (sameRounds || hasPendingRound) {
+        roundButton->setText(QString("Тур %1").arg(currentRound));
+    } else if (!allRounds.isEmpty()) {
+        currentRound = allRounds.last().round;
         roundButton->setText(QString("Тур %1").arg(currentRound));
     } else {
         currentRound = -1;
         roundButton->setText("Все туры");
     }
+    trace.setRows(allRounds.size());
 
     loadMatchesForCurrentRound();
-    loadStandings();
 }
 
 void SportsTracker::loadMatchesForCurrentRound()
 {
-    matchesList->clear();
+    TRACE_SCOPE("SportsTracker::loadMatchesForCurrentRound");
+    // Сброс отменяет загрузку страниц предыдущего тура; первую страницу
+    // запрашиваем сразу, остальные модель запросит сама при прокрутке
+    matchesModel->reset();
     if (currentTournamentId == -1) return;
 
-    QSqlQuery matchesQuery(db);
-    QString queryStr =
-        "SELECT m.id, m.date, t1.name, t2.name, "
-        "CASE WHEN m.score IS NULL THEN '-' ELSE m.score END as score "
-        "FROM matches m "
-        "JOIN teams t1 ON m.team1_id = t1.id "
-        "JOIN teams t2 ON m.team2_id = t2.id "
-        "WHERE m.tournament_id = ? ";
-
-    if (currentRound > 0) {
-        queryStr += "AND m.round = ? ";
+    auto cached = roundMatches.constFind(currentRound);
+    if (cached != roundMatches.constEnd()) {
+        // Тур уже загружен целиком (открывался раньше или подгружен заранее)
+        dataWorker->cancel(DataWorker::MatchesChannel);
+        matchesModel->appendPage(cached.value(), true);
+    } else {
+        matchesModel->fetchMore(QModelIndex());
     }
 
-    queryStr += "ORDER BY m.date DESC";
-
-    matchesQuery.prepare(queryStr);
-    matchesQuery.addBindValue(currentTournamentId);
-
-    if (currentRound > 0) {
-        matchesQuery.addBindValue(currentRound);
-    }
+    prefetchAdjacentRounds();
+}
 
-    if (!matchesQuery.exec()) {
-        qDebug() << "Ошибка загрузки матчей:" << matchesQuery.lastError().text();
-        return;
-    }
+void SportsTracker::fetchMatchPage(const MatchPageCursor &after)
+{
+    if (currentTournamentId == -1) return;
 
-    while (matchesQuery.next()) {
-        QString score = matchesQuery.value(4).toString();
-        if (score == "-") score = "? - ?";
+    matchesTicket = dataWorker->requestMatchPage(currentTournamentId, currentRound, after, MatchPageSize);
+}
 
-        QString matchText = QString("%1: %2 %3 %4")
-            .arg(matchesQuery.value(1).toDate().toString("dd.MM.yyyy"))
-            .arg(matchesQuery.value(2).toString())
-            .arg(score)
-            .arg(matchesQuery.value(3).toString());
+void SportsTracker::onMatchPageLoaded(quint64 ticket, const QVector<MatchListRow> &rows, bool last)
+{
+    TraceScope trace("SportsTracker::onMatchPageLoaded");
+    if (ticket != matchesTicket) return;
 
-        QListWidgetItem *item = new QListWidgetItem(matchText, matchesList);
-        item->setData(Qt::UserRole, matchesQuery.value(0).toInt());
+    // Тур, уместившийся в первую страницу, запоминаем для повторного выбора
+    if (currentRound > 0 && last && matchesModel->rowCount() == 0) {
+        roundMatches.insert(currentRound, rows);
     }
+    matchesModel->appendPage(rows, last);
+    trace.setRows(matchesModel->rowCount());
 }
 
-void SportsTracker::loadStandings()
+void SportsTracker::prefetchAdjacentRounds()
 {
-    standingsTable->clear();
-    if (currentTournamentId == -1) return;
-
-    QSqlQuery standingsQuery(db);
-    standingsQuery.prepare(
-        "SELECT s.position, t.name, s.points, s.games_played, s.wins, s.draws, s.losses, "
-        "s.goals_for, s.goals_against, (s.goals_for - s.goals_against) as goal_difference "
-        "FROM standings s "
-        "JOIN teams t ON s.team_id = t.id "
-        "WHERE s.tournament_id = ? "
-        "ORDER BY s.position"
-    );
-    standingsQuery.addBindValue(currentTournamentId);
-
-    if (!standingsQuery.exec()) {
-        qDebug() << "Ошибка загрузки турнирной таблицы:" << standingsQuery.lastError().text();
-        return;
+    QList<int> rounds;
+    for (int i = 0; i < allRounds.size(); ++i) {
+        if (allRounds[i].round != currentRound) continue;
+
+        for (int neighbour : {i + 1, i - 1}) {
+            if (neighbour < 0 || neighbour >= allRounds.size()) continue;
+            int round = allRounds[neighbour].round;
+            if (!roundMatches.contains(round)) {
+                rounds.append(round);
+            }
+        }
+        break;
     }
 
-    standingsTable->setRowCount(0);
-    standingsTable->setColumnCount(10);
-    QStringList headers = {"Поз", "Команда", "О", "И", "В", "Н", "П", "ЗГ", "ПГ", "РГ"};
-    standingsTable->setHorizontalHeaderLabels(headers);
+    if (rounds.isEmpty()) {
+        dataWorker->cancel(DataWorker::RoundPrefetchChannel);
+    } else {
+        dataWorker->requestRoundPrefetch(currentTournamentId, rounds, MatchPageSize);
+    }
+}
 
-    while (standingsQuery.next()) {
-        int row = standingsTable->rowCount();
-        standingsTable->insertRow(row);
+void SportsTracker::onRoundPrefetched(quint64 ticket, int tournamentId, int round,
+                                      const QVector<MatchListRow> &rows, bool complete)
+{
+    TRACE_SCOPE("SportsTracker::onRoundPrefetched");
+    Q_UNUSED(ticket);
+    // Большие туры по-прежнему читаются постранично при прокрутке
+    if (tournamentId != currentTournamentId || !complete) return;
+    roundMatches.insert(round, rows);
+}
 
-        int position = standingsQuery.value(0).toInt();
-        QColor rowColor = Qt::white;
+void SportsTracker::loadStandings()
+{
+    standingsModel->clear();
+    dataWorker->cancel(DataWorker::ProjectionChannel);
+    if (currentTournamentId == -1) return;
 
-        if (position <= 4) {
-            rowColor = QColor(220, 255, 220);
-        } else if (position <= 6) {
-            rowColor = QColor(220, 220, 255);
-        } else if (position >= 18) {
-            rowColor = QColor(255, 220, 220);
-        }
+    standingsTicket = dataWorker->requestStandings(currentTournamentId);
+}
 
-        for (int col = 0; col < 10; ++col) {
-            QTableWidgetItem *item = new QTableWidgetItem(standingsQuery.value(col).toString());
-            item->setTextAlignment(col == 1 ? Qt::AlignLeft | Qt::AlignVCenter : Qt::AlignCenter);
-            item->setBackground(rowColor);
+void SportsTracker::onStandingsLoaded(quint64 ticket, const QVector<StandingRow> &rows)
+{
+    TraceScope trace("SportsTracker::onStandingsLoaded");
+    if (ticket != standingsTicket) return;
 
-            if (col == 1) {
-                item->setToolTip(standingsQuery.value(col).toString());
-            }
+    // Совпавшая с показанной (из снимка) таблица не перестраивается
+    if (rows != standingsModel->standings()) {
+        standingsModel->setRows(rows);
+        resizeStandingsColumns();
+    }
+    trace.setRows(standingsModel->rowCount());
 
-            standingsTable->setItem(row, col, item);
-        }
+    // Прогноз считается по той же таблице в фоне и дописывается в её столбцы
+    if (!rows.isEmpty() && currentTournamentId != -1) {
+        projectionTicket = dataWorker->requestSeasonProjection(currentTournamentId, SeasonSimulations);
     }
+}
 
+void SportsTracker::resizeStandingsColumns()
+{
     standingsTable->setColumnWidth(0, 40);
     standingsTable->setColumnWidth(1, 300);
     standingsTable->setColumnWidth(2, 30);
@@ -518,18 +870,138 @@ void SportsTracker::loadStandings()
     standingsTable->setColumnWidth(7, 30);
     standingsTable->setColumnWidth(8, 30);
     standingsTable->setColumnWidth(9, 30);
+    standingsTable->setColumnWidth(StandingsModel::TitleChanceColumn, 55);
+    standingsTable->setColumnWidth(StandingsModel::EuropeChanceColumn, 55);
+    standingsTable->setColumnWidth(StandingsModel::RelegationChanceColumn, 55);
 
     standingsTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Interactive);
 }
 
+void SportsTracker::onDatabaseChanged()
+{
+    TRACE_SCOPE("SportsTracker::onDatabaseChanged");
+    // Ранее загруженные страницы матчей и туры могли устареть
+    detailsCache.clear();
+    roundMatches.clear();
+
+    if (currentTournamentId == -1 || stackedWidget->currentIndex() != 1) return;
+
+    MatchHeader match;
+    if (leftPanelStack->currentIndex() == 1) {
+        match = currentMatchHeader;
+    }
+    liveTicket = dataWorker->requestLiveRefresh(currentTournamentId, currentRound, match, MatchPageSize);
+
+    if (tournamentTabs->currentIndex() == 1) {
+        leadersTicket = dataWorker->requestLeaders(currentTournamentId,
+                                                   leadersCategory->currentData().toInt(), LeadersCount);
+    }
+    if (tournamentTabs->currentIndex() == 2) {
+        teamStatsTicket = dataWorker->requestTeamStats(currentTournamentId);
+    }
+}
+
+void SportsTracker::onLiveRefreshed(quint64 ticket, const LiveUpdate &update)
+{
+    TraceScope trace("SportsTracker::onLiveRefreshed");
+    if (ticket != liveTicket || update.tournamentId != currentTournamentId) return;
+
+    // Обновляются только изменившиеся строки: выделение и прокрутка не сбрасываются.
+    // Прогноз сезона не пересчитывается на каждое изменение, чтобы не занимать процессор
+    if (update.round == currentRound) {
+        if (!matchesModel->updateFirstPage(update.matches, update.matchesComplete)) {
+            // Состав тура изменился: страница, запрошенная от старого курсора,
+            // легла бы после новой первой страницы
+            dataWorker->cancel(DataWorker::MatchesChannel);
+            matchesTicket = 0;
+            matchesModel->reset();
+            matchesModel->appendPage(update.matches, update.matchesComplete);
+        }
+        if (update.matchesComplete && currentRound > 0) {
+            roundMatches.insert(currentRound, update.matches);
+        }
+    }
+
+    if (!update.standings.isEmpty()) {
+        standingsModel->updateRows(update.standings);
+    }
+    trace.setRows(matchesModel->rowCount() + standingsModel->rowCount());
+
+    if (update.matchId == -1 || update.matchId != currentMatchId) return;
+
+    for (const MatchListRow &row : update.matches) {
+        if (row.id == currentMatchId) {
+            matchTitle->setText(MatchListModel::displayText(row));
+            break;
+        }
+    }
+    scorersModel->updateEvents(update.events);
+    statsModel->updateStats(update.stats);
+    trace.setRows(matchesModel->rowCount() + standingsModel->rowCount()
+                  + scorersModel->rowCount() + statsModel->rowCount());
+}
+
+void SportsTracker::loadLeaders()
+{
+    leadersModel->clear();
+    if (currentTournamentId == -1 || tournamentTabs->currentIndex() != 1) {
+        dataWorker->cancel(DataWorker::LeadersChannel);
+        return;
+    }
+
+    leadersTicket = dataWorker->requestLeaders(currentTournamentId,
+                                               leadersCategory->currentData().toInt(), LeadersCount);
+}
+
+void SportsTracker::onLeadersLoaded(quint64 ticket, int tournamentId, int category,
+                                    const QVector<LeaderRow> &rows)
+{
+    TraceScope trace("SportsTracker::onLeadersLoaded");
+    if (ticket != leadersTicket || tournamentId != currentTournamentId) return;
+    leadersModel->setRows(Leaderboard::Category(category), rows);
+    trace.setRows(leadersModel->rowCount());
+}
+
+void SportsTracker::loadTeamStats()
+{
+    if (currentTournamentId == -1 || tournamentTabs->currentIndex() != 2) {
+        dataWorker->cancel(DataWorker::TeamStatsChannel);
+        return;
+    }
+
+    // Таблица прошлого турнира не показывается, пока считается новая
+    if (teamStatsModel->tournamentId() != currentTournamentId) {
+        teamStatsModel->clear();
+    }
+    teamStatsTicket = dataWorker->requestTeamStats(currentTournamentId);
+}
+
+void SportsTracker::onTeamStatsLoaded(quint64 ticket, const TeamStatsTable &table)
+{
+    TraceScope trace("SportsTracker::onTeamStatsLoaded");
+    if (ticket != teamStatsTicket || table.tournamentId != currentTournamentId) return;
+    teamStatsModel->setTable(table);
+    trace.setRows(teamStatsModel->rowCount());
+}
+
+void SportsTracker::onSeasonProjectionLoaded(quint64 ticket, int tournamentId,
+                                             const QVector<SeasonProjection> &rows)
+{
+    TraceScope trace("SportsTracker::onSeasonProjectionLoaded");
+    if (ticket != projectionTicket || tournamentId != currentTournamentId) return;
+    standingsModel->setProjections(rows);
+    trace.setRows(rows.size());
+}
+
 void SportsTracker::showRoundSelectionPopup()
 {
+    TRACE_SCOPE("SportsTracker::showRoundSelectionPopup");
     if (allRounds.isEmpty()) return;
 
     if (!roundsPopup) {
+        // Попап и его кнопки создаются один раз; при листании меняются только подписи
         roundsPopup = new QWidget(nullptr, Qt::Popup);
-        roundsPopup->setStyleSheet(
-            "background: white; border: 1px solid #ddd; border-radius: 4px;");
+        roundsPopup->setObjectName("roundsPopup");
 
         QVBoxLayout *layout = new QVBoxLayout(roundsPopup);
         layout->setContentsMargins(5, 5, 5, 5);
@@ -538,73 +1010,50 @@ void SportsTracker::showRoundSelectionPopup()
         roundsGroup = new QButtonGroup(this);
         connect(roundsGroup, QOverload<QAbstractButton*>::of(&QButtonGroup::buttonClicked),
                 this, &SportsTracker::onRoundSelected);
-    }
 
-    // Очищаем предыдущие кнопки
-    QLayoutItem* child;
-    while ((child = roundsPopup->layout()->takeAt(0)) != nullptr) {
-        delete child->widget();
-        delete child;
-    }
-    roundsGroup->buttons().clear();
+        for (int i = 0; i < roundsPerPage; ++i) {
+            QPushButton *roundBtn = new QPushButton();
+            roundBtn->setObjectName("roundPageButton");
+            roundsGroup->addButton(roundBtn);
+            layout->addWidget(roundBtn);
+            roundPageButtons.append(roundBtn);
+        }
 
-    // Добавляем кнопки для текущей страницы
-    int start = currentRoundPage * roundsPerPage;
-    int end = qMin(start + roundsPerPage, allRounds.size());
-
-    for (int i = start; i < end; ++i) {
-        int round = allRounds[i];
-        QPushButton *roundBtn = new QPushButton(QString::number(round));
-        roundBtn->setStyleSheet(
-            "QPushButton { padding: 5px 10px; background: white; border: 1px solid #ddd; "
-            "border-radius: 3px; }"
-            "QPushButton:hover { background: #e6f2ff; }");
-        roundsGroup->addButton(roundBtn, round);
-        roundsPopup->layout()->addWidget(roundBtn);
-    }
+        // Кнопки навигации
+        roundsNavigation = new QWidget();
+        QHBoxLayout *navLayout = new QHBoxLayout(roundsNavigation);
+        navLayout->setContentsMargins(0, 0, 0, 0);
+
+        prevRoundsButton = new QPushButton("<");
+        prevRoundsButton->setFixedWidth(30);
+        prevRoundsButton->setObjectName("roundsNavButton");
 
-    // Добавляем кнопки навигации, если нужно
-    if (allRounds.size() > roundsPerPage) {
-        QHBoxLayout *navLayout = new QHBoxLayout();
-
-        QPushButton *prevBtn = new QPushButton("<");
-        prevBtn->setEnabled(currentRoundPage > 0);
-        prevBtn->setFixedWidth(30);
-        prevBtn->setStyleSheet(
-            "QPushButton { padding: 2px; background: #f0f0f0; border: 1px solid #ddd; "
-            "border-radius: 3px; }"
-            "QPushButton:hover { background: #e0e0e0; }"
-            "QPushButton:disabled { color: #aaa; }");
-
-        QPushButton *nextBtn = new QPushButton(">");
-        nextBtn->setEnabled((currentRoundPage + 1) * roundsPerPage < allRounds.size());
-        nextBtn->setFixedWidth(30);
-        nextBtn->setStyleSheet(prevBtn->styleSheet());
-
-        connect(prevBtn, &QPushButton::clicked, [this]() {
+        nextRoundsButton = new QPushButton(">");
+        nextRoundsButton->setFixedWidth(30);
+        nextRoundsButton->setObjectName("roundsNavButton");
+
+        connect(prevRoundsButton, &QPushButton::clicked, [this]() {
             if (currentRoundPage > 0) {
                 currentRoundPage--;
-                showRoundSelectionPopup();
+                updateRoundButtons();
             }
         });
 
-        connect(nextBtn, &QPushButton::clicked, [this]() {
+        connect(nextRoundsButton, &QPushButton::clicked, [this]() {
             if ((currentRoundPage + 1) * roundsPerPage < allRounds.size()) {
                 currentRoundPage++;
-                showRoundSelectionPopup();
+                updateRoundButtons();
             }
         });
 
-        navLayout->addWidget(prevBtn);
+        navLayout->addWidget(prevRoundsButton);
         navLayout->addStretch();
-        navLayout->addWidget(nextBtn);
-
-        QVBoxLayout* mainLayout = qobject_cast<QVBoxLayout*>(roundsPopup->layout());
-        if (mainLayout) {
-            mainLayout->addLayout(navLayout);
-        }
+        navLayout->addWidget(nextRoundsButton);
+        layout->addWidget(roundsNavigation);
     }
 
+    updateRoundButtons();
+
     // Показываем попап
     QPoint pos = roundButton->mapToGlobal(QPoint(0, roundButton->height()));
     roundsPopup->move(pos);
@@ -612,8 +1061,38 @@ void SportsTracker::showRoundSelectionPopup()
     roundsPopup->show();
 }
 
+void SportsTracker::updateRoundButtons()
+{
+    int start = currentRoundPage * roundsPerPage;
+
+    for (int i = 0; i < roundPageButtons.size(); ++i) {
+        QPushButton *roundBtn = roundPageButtons[i];
+        int index = start + i;
+        if (index >= allRounds.size()) {
+            roundBtn->hide();
+            continue;
+        }
+
+        const RoundInfo &info = allRounds[index];
+        roundBtn->setText(QString::number(info.round));
+        roundBtn->setToolTip(QString("Матчей: %1, сыграно: %2\n%3 – %4")
+            .arg(info.matchCount)
+            .arg(info.finishedCount)
+            .arg(shortDate(info.firstDate))
+            .arg(shortDate(info.lastDate)));
+        roundsGroup->setId(roundBtn, info.round);
+        roundBtn->show();
+    }
+
+    roundsNavigation->setVisible(allRounds.size() > roundsPerPage);
+    prevRoundsButton->setEnabled(currentRoundPage > 0);
+    nextRoundsButton->setEnabled((currentRoundPage + 1) * roundsPerPage < allRounds.size());
+    roundsPopup->adjustSize();
+}
+
 void SportsTracker::onRoundSelected(QAbstractButton *button)
 {
+    TRACE_SCOPE("SportsTracker::onRoundSelected");
     if (!roundsPopup || !button) return;
     roundsPopup->hide();
     currentRound = roundsGroup->id(button);
@@ -621,418 +1100,237 @@ void SportsTracker::onRoundSelected(QAbstractButton *button)
     loadMatchesForCurrentRound();
 }
 
-void SportsTracker::showMatchStats(QListWidgetItem *item)
+void SportsTracker::showMatchStats(const QModelIndex &index)
 {
-    if (!item) return;
-
-    currentMatchId = item->data(Qt::UserRole).toInt();
-    matchTitle->setText(item->text());
-
-    statsTable->clear();
-    lineupsTable->clear();
-    scorersTable->clear();
-    team1RecentMatches->clear();
-    team2RecentMatches->clear();
-    headToHeadMatches->clear();
-
-    QSqlQuery matchQuery(db);
-    matchQuery.prepare(
-        "SELECT t1.name, t2.name, m.date "
-        "FROM matches m "
-        "JOIN teams t1 ON m.team1_id = t1.id "
-        "JOIN teams t2 ON m.team2_id = t2.id "
-        "WHERE m.id = ?"
-    );
-    matchQuery.addBindValue(currentMatchId);
-
-    if (matchQuery.exec() && matchQuery.next()) {
-        QString team1 = matchQuery.value(0).toString();
-        QString team2 = matchQuery.value(1).toString();
-        QDate matchDate = QDate::fromString(matchQuery.value(2).toString(), Qt::ISODate);
-
-        loadMatchStats(currentMatchId, team1, team2);
-        loadLineups(currentMatchId, team1, team2);
-        loadScorers(currentMatchId, team1, team2);
-        loadRecentMatches(team1, matchDate, team1RecentMatches);
-        loadRecentMatches(team2, matchDate, team2RecentMatches);
-        loadHeadToHeadMatches(team1, team2, matchDate, headToHeadMatches);
+    TRACE_SCOPE("SportsTracker::showMatchStats");
+    if (!index.isValid()) return;
+
+    // id команд и дата берутся из строки списка и передаются дальше без поиска по имени
+    currentMatchHeader = SportsRepository::headerFor(matchesModel->rowAt(index.row()));
+    currentMatchId = currentMatchHeader.id;
+    matchTitle->setText(index.data(Qt::DisplayRole).toString());
+    leftPanelStack->setCurrentIndex(1);
+
+    const MatchDetails *cached = detailsCache.find(currentMatchId);
+    if (cached) {
+        // Страница уже открывалась или была подгружена заранее: обходимся без запросов
+        dataWorker->cancel(DataWorker::MatchDetailsChannel);
+        matchDetailsTicket = 0;
+        pendingParts = 0;
+        showMatchDetails(*cached);
     } else {
-        qDebug() << "Ошибка загрузки данных матча:" << matchQuery.lastError().text();
+        statsModel->clear();
+        fillLineups(MatchHeader(), QVector<LineupEntry>());
+        scorersModel->clear();
+        team1RecentModel->clear();
+        team2RecentModel->clear();
+        headToHeadModel->clear();
+
+        pendingDetails = MatchDetails();
+        pendingDetails.header = currentMatchHeader;
+        pendingParts = 0;
+
+        // Предыдущий незавершённый запрос становится устаревшим и будет пропущен.
+        // Панели заполняются по мере прихода результатов.
+        matchDetailsTicket = dataWorker->requestMatchDetails(currentMatchHeader);
     }
 
-    leftPanelStack->setCurrentIndex(1);
+    prefetchNeighbourMatches(index.row());
 }
 
-void SportsTracker::loadMatchStats(int matchId, const QString& team1, const QString& team2)
+void SportsTracker::showMatchDetails(const MatchDetails &details)
 {
-    QSqlQuery statsQuery(db);
-    statsQuery.prepare(
-        "SELECT stat_name, "
-        "(SELECT stat_value FROM match_stats WHERE match_id = ? AND team_id = (SELECT id FROM teams WHERE name = ?) AND stat_name = ms.stat_name) as team1_value, "
-        "(SELECT stat_value FROM match_stats WHERE match_id = ? AND team_id = (SELECT id FROM teams WHERE name = ?) AND stat_name = ms.stat_name) as team2_value "
-        "FROM match_stats ms WHERE match_id = ? GROUP BY stat_name"
-    );
-    statsQuery.addBindValue(matchId);
-    statsQuery.addBindValue(team1);
-    statsQuery.addBindValue(matchId);
-    statsQuery.addBindValue(team2);
-    statsQuery.addBindValue(matchId);
-
-    if (statsQuery.exec()) {
-        statsTable->setRowCount(0);
-        statsTable->setColumnCount(3);
-
-        // Убираем стандартные заголовки
-        statsTable->setHorizontalHeaderLabels({"", "", ""});
-        statsTable->horizontalHeader()->setVisible(false);
-
-        // Добавляем заголовки с названиями команд
-        QFont headerFont;
-        headerFont.setBold(true);
-        headerFont.setPointSize(12);
-
-        QTableWidgetItem *team1Header = new QTableWidgetItem(team1);
-        team1Header->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        team1Header->setFont(headerFont);
-
-        QTableWidgetItem *team2Header = new QTableWidgetItem(team2);
-        team2Header->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        team2Header->setFont(headerFont);
-
-        statsTable->insertRow(0);
-        statsTable->setItem(0, 0, team1Header);
-        statsTable->setItem(0, 2, team2Header);
-
-        // Основные данные статистики
-        int currentRow = 1;
-        while (statsQuery.next()) {
-            statsTable->insertRow(currentRow);
-
-            // Команда 1
-            QTableWidgetItem *team1Item = new QTableWidgetItem(statsQuery.value(1).toString());
-            team1Item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-            statsTable->setItem(currentRow, 0, team1Item);
-
-            // Название показателя
-            QTableWidgetItem *statNameItem = new QTableWidgetItem(statsQuery.value(0).toString());
-            statNameItem->setTextAlignment(Qt::AlignCenter);
-            statNameItem->setFont(headerFont);
-            statsTable->setItem(currentRow, 1, statNameItem);
-
-            // Команда 2
-            QTableWidgetItem *team2Item = new QTableWidgetItem(statsQuery.value(2).toString());
-            team2Item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            statsTable->setItem(currentRow, 2, team2Item);
-
-            currentRow++;
-        }
-
-        // Настройка внешнего вида таблицы
-        statsTable->verticalHeader()->setVisible(false);
-        statsTable->setShowGrid(false);
-        statsTable->setStyleSheet(
-            "QTableWidget { border: none; background: white; }"
-            "QTableWidget::item { border: none; padding: 5px; }");
+    TraceScope trace("SportsTracker::showMatchDetails");
+    statsModel->setStats(details.header, details.stats);
+    fillLineups(details.header, details.lineups);
+    scorersModel->setEvents(details.header, details.events);
+    scorersTable->resizeColumnsToContents();
+    team1RecentModel->setRows(details.team1Recent);
+    team1RecentMatches->resizeColumnsToContents();
+    team2RecentModel->setRows(details.team2Recent);
+    team2RecentMatches->resizeColumnsToContents();
+    headToHeadModel->setRows(details.headToHead);
+    headToHeadMatches->resizeColumnsToContents();
+    trace.setRows(statsModel->rowCount() + lineupsModel->rowCount() + scorersModel->rowCount()
+                  + team1RecentModel->rowCount() + team2RecentModel->rowCount()
+                  + headToHeadModel->rowCount());
+}
 
-        // Настройка ширины столбцов
-        statsTable->setColumnWidth(0, 175);
-        statsTable->setColumnWidth(1, 250);
-        statsTable->setColumnWidth(2, 150);
-        statsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+void SportsTracker::prefetchNeighbourMatches(int row)
+{
+    // Соседние строки списка — самые вероятные следующие матчи при просмотре тура
+    QVector<MatchHeader> headers;
+    for (int neighbour : {row + 1, row - 1}) {
+        if (neighbour < 0 || neighbour >= matchesModel->rowCount()) continue;
+        MatchHeader header = SportsRepository::headerFor(matchesModel->rowAt(neighbour));
+        if (!detailsCache.contains(header.id)) {
+            headers.append(header);
+        }
+    }
 
+    if (headers.isEmpty()) {
+        dataWorker->cancel(DataWorker::PrefetchChannel);
     } else {
-        qDebug() << "Ошибка загрузки статистики матча:" << statsQuery.lastError().text();
+        dataWorker->requestMatchPrefetch(headers);
     }
 }
 
-void SportsTracker::loadLineups(int matchId, const QString& team1, const QString& team2)
+void SportsTracker::onMatchDetailsPrefetched(quint64 ticket, const MatchDetails &details)
 {
-    // Получаем фактические ID команд
-    int team1Id = -1, team2Id = -1;
-    QSqlQuery teamQuery(db);
-
-    teamQuery.prepare("SELECT id FROM teams WHERE name = ?");
-    teamQuery.addBindValue(team1);
-    if (teamQuery.exec() && teamQuery.next()) {
-        team1Id = teamQuery.value(0).toInt();
+    TRACE_SCOPE("SportsTracker::onMatchDetailsPrefetched");
+    Q_UNUSED(ticket);
+    if (!detailsCache.contains(details.header.id)) {
+        detailsCache.insert(details);
     }
+}
 
-    teamQuery.prepare("SELECT id FROM teams WHERE name = ?");
-    teamQuery.addBindValue(team2);
-    if (teamQuery.exec() && teamQuery.next()) {
-        team2Id = teamQuery.value(0).toInt();
+void SportsTracker::markDetailsPartLoaded(int part)
+{
+    pendingParts |= part;
+    if (pendingParts == AllDetailsParts) {
+        detailsCache.insert(pendingDetails);
+        pendingParts = 0;
     }
+}
 
-    // Загружаем составы для обеих команд, разделяя на основных и запасных
-    QVector<QStringList> team1Starters;
-    QVector<QStringList> team1Substitutes;
-    QVector<QStringList> team2Starters;
-    QVector<QStringList> team2Substitutes;
-
-    QSqlQuery lineupsQuery(db);
-    lineupsQuery.prepare(
-        "SELECT p.name, ml.team_id, ml.position, ml.is_starting, ml.jersey_number "
-        "FROM match_lineups ml "
-        "JOIN players p ON ml.player_id = p.id "
-        "WHERE ml.match_id = ? "
-        "ORDER BY ml.team_id, ml.is_starting DESC, ml.position"
-    );
-    lineupsQuery.addBindValue(matchId);
-
-    if (!lineupsQuery.exec()) {
-        qDebug() << "Ошибка загрузки составов:" << lineupsQuery.lastError().text();
-        return;
-    }
+void SportsTracker::onMatchStatsLoaded(quint64 ticket, const QVector<StatRow> &stats)
+{
+    TraceScope trace("SportsTracker::onMatchStatsLoaded");
+    if (ticket != matchDetailsTicket) return;
+    statsModel->setStats(currentMatchHeader, stats);
+    trace.setRows(statsModel->rowCount());
+    pendingDetails.stats = stats;
+    markDetailsPartLoaded(StatsPart);
+}
 
-    while (lineupsQuery.next()) {
-        int teamId = lineupsQuery.value(1).toInt();
-        QStringList playerData;
-        playerData << lineupsQuery.value(4).toString()  // номер
-                   << lineupsQuery.value(0).toString()  // имя
-                   << lineupsQuery.value(2).toString(); // позиция
-
-        if (teamId == team1Id) {
-            if (lineupsQuery.value(3).toBool()) {
-                team1Starters.append(playerData);
-            } else {
-                team1Substitutes.append(playerData);
-            }
-        } else if (teamId == team2Id) {
-            if (lineupsQuery.value(3).toBool()) {
-                team2Starters.append(playerData);
-            } else {
-                team2Substitutes.append(playerData);
-            }
-        }
-    }
+void SportsTracker::onLineupsLoaded(quint64 ticket, const QVector<LineupEntry> &lineups)
+{
+    TraceScope trace("SportsTracker::onLineupsLoaded");
+    if (ticket != matchDetailsTicket) return;
+    fillLineups(currentMatchHeader, lineups);
+    trace.setRows(lineupsModel->rowCount());
+    pendingDetails.lineups = lineups;
+    markDetailsPartLoaded(LineupsPart);
+}
 
-    // Настраиваем таблицу для отображения составов
-    lineupsTable->setRowCount(0);
-    lineupsTable->setColumnCount(4); // 2 колонки (игроки команд) с номерами и именами
+void SportsTracker::onEventsLoaded(quint64 ticket, const QVector<EventRow> &events)
+{
+    TraceScope trace("SportsTracker::onEventsLoaded");
+    if (ticket != matchDetailsTicket) return;
+    scorersModel->setEvents(currentMatchHeader, events);
+    scorersTable->resizeColumnsToContents();
+    trace.setRows(scorersModel->rowCount());
+    pendingDetails.events = events;
+    markDetailsPartLoaded(EventsPart);
+}
 
-    // Убираем стандартные заголовки
-    lineupsTable->setHorizontalHeaderLabels({"", "", "", ""});
-    lineupsTable->horizontalHeader()->setVisible(false);
-    lineupsTable->verticalHeader()->setVisible(false);
+void SportsTracker::onRecentMatchesLoaded(quint64 ticket, int side, const QVector<HistoryRow> &rows)
+{
+    TraceScope trace("SportsTracker::onRecentMatchesLoaded");
+    if (ticket != matchDetailsTicket) return;
+    if (side == 1) {
+        team1RecentModel->setRows(rows);
+        team1RecentMatches->resizeColumnsToContents();
+        trace.setRows(team1RecentModel->rowCount());
+        pendingDetails.team1Recent = rows;
+        markDetailsPartLoaded(Team1RecentPart);
+    } else {
+        team2RecentModel->setRows(rows);
+        team2RecentMatches->resizeColumnsToContents();
+        trace.setRows(team2RecentModel->rowCount());
+        pendingDetails.team2Recent = rows;
+        markDetailsPartLoaded(Team2RecentPart);
+    }
+}
 
-    // Настраиваем стиль таблицы
-    lineupsTable->setStyleSheet(
-        "QTableWidget { border: none; background: white; }"
-        "QTableWidget::item { border: none; padding: 3px; }");
-
-    // Добавляем заголовок "Основной состав"
-    int currentRow = 0;
-    lineupsTable->insertRow(currentRow);
-    QTableWidgetItem *startersHeader = new QTableWidgetItem("Основной состав");
-    startersHeader->setTextAlignment(Qt::AlignCenter);
-    QFont headerFont;
-    headerFont.setBold(true);
-    headerFont.setPointSize(12);
-    startersHeader->setFont(headerFont);
-    lineupsTable->setItem(currentRow, 0, startersHeader);
-    lineupsTable->setSpan(currentRow, 0, 1, 4);
-    currentRow++;
-
-    // Определяем максимальное количество игроков в стартовых составах
-    int maxStarters = qMax(team1Starters.size(), team2Starters.size());
-
-    // Заполняем стартовые составы
-    for (int i = 0; i < maxStarters; ++i) {
-        lineupsTable->insertRow(currentRow);
-
-        // Игрок команды 1
-        if (i < team1Starters.size()) {
-            QString playerText = team1Starters[i][0] + " " + team1Starters[i][1] + " (" + team1Starters[i][2] + ")";
-            QTableWidgetItem *team1Item = new QTableWidgetItem(playerText);
-            team1Item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-            lineupsTable->setItem(currentRow, 0, team1Item);
-            lineupsTable->setItem(currentRow, 1, new QTableWidgetItem("")); // Пустая ячейка-разделитель
-        }
+void SportsTracker::onHeadToHeadLoaded(quint64 ticket, const QVector<HistoryRow> &rows)
+{
+    TraceScope trace("SportsTracker::onHeadToHeadLoaded");
+    if (ticket != matchDetailsTicket) return;
+    headToHeadModel->setRows(rows);
+    headToHeadMatches->resizeColumnsToContents();
+    trace.setRows(headToHeadModel->rowCount());
+    pendingDetails.headToHead = rows;
+    markDetailsPartLoaded(HeadToHeadPart);
+}
 
-        // Игрок команды 2
-        if (i < team2Starters.size()) {
-            QString playerText = team2Starters[i][0] + " " + team2Starters[i][1] + " (" + team2Starters[i][2] + ")";
-            QTableWidgetItem *team2Item = new QTableWidgetItem(playerText);
-            team2Item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            lineupsTable->setItem(currentRow, 2, team2Item);
-            lineupsTable->setItem(currentRow, 3, new QTableWidgetItem("")); // Пустая ячейка-разделитель
+void SportsTracker::fillLineups(const MatchHeader& header, const QVector<LineupEntry>& lineups)
+{
+    TraceScope trace("SportsTracker::fillLineups");
+    lineupsModel->setLineups(header, lineups);
+
+    // Заголовки разделов занимают обе колонки
+    lineupsTable->clearSpans();
+    for (int row = 0; row < lineupsModel->rowCount(); ++row) {
+        if (lineupsModel->index(row, 0).data(LineupsModel::SectionRole).toBool()) {
+            lineupsTable->setSpan(row, 0, 1, LineupsModel::ColumnCount);
         }
-
-        currentRow++;
     }
+    trace.setRows(lineupsModel->rowCount());
+}
 
-    // Добавляем заголовок "Запасной состав"
-    lineupsTable->insertRow(currentRow);
-    QTableWidgetItem *substitutesHeader = new QTableWidgetItem("Запасной состав");
-    substitutesHeader->setTextAlignment(Qt::AlignCenter);
-    substitutesHeader->setFont(headerFont);
-    lineupsTable->setItem(currentRow, 0, substitutesHeader);
-    lineupsTable->setSpan(currentRow, 0, 1, 4);
-    currentRow++;
-
-    // Определяем максимальное количество игроков в запасных составах
-    int maxSubstitutes = qMax(team1Substitutes.size(), team2Substitutes.size());
-
-    // Заполняем запасные составы
-    for (int i = 0; i < maxSubstitutes; ++i) {
-        lineupsTable->insertRow(currentRow);
-
-        // Игрок команды 1
-        if (i < team1Substitutes.size()) {
-            QString playerText = team1Substitutes[i][0] + " " + team1Substitutes[i][1] + " (" + team1Substitutes[i][2] + ")";
-            QTableWidgetItem *team1Item = new QTableWidgetItem(playerText);
-            team1Item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-            lineupsTable->setItem(currentRow, 0, team1Item);
-            lineupsTable->setItem(currentRow, 1, new QTableWidgetItem("")); // Пустая ячейка-разделитель
-        }
-
-        // Игрок команды 2
-        if (i < team2Substitutes.size()) {
-            QString playerText = team2Substitutes[i][0] + " " + team2Substitutes[i][1] + " (" + team2Substitutes[i][2] + ")";
-            QTableWidgetItem *team2Item = new QTableWidgetItem(playerText);
-            team2Item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            lineupsTable->setItem(currentRow, 2, team2Item);
-            lineupsTable->setItem(currentRow, 3, new QTableWidgetItem("")); // Пустая ячейка-разделитель
-        }
+void SportsTracker::saveTrace()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Сохранить трассировку",
+                                                QDir::homePath() + "/sportstracker-trace.json",
+                                                "Chrome Trace (*.json)");
+    if (path.isEmpty()) return;
 
-        currentRow++;
+    if (!Trace::dumpChromeTrace(path)) {
+        QMessageBox::warning(this, "Ошибка", "Не удалось сохранить трассировку");
     }
-
-    // Настраиваем ширину столбцов
-    lineupsTable->setColumnWidth(0, 250); // Игроки команды 1
-    lineupsTable->setColumnWidth(1, 20);  // Разделитель
-    lineupsTable->setColumnWidth(2, 250); // Игроки команды 2
-    lineupsTable->setColumnWidth(3, 20);  // Разделитель
 }
 
-void SportsTracker::loadScorers(int matchId, const QString& team1, const QString& team2)
+void SportsTracker::runSearch()
 {
-    QSqlQuery scorersQuery(db);
-    scorersQuery.prepare(
-        "SELECT me.event_type, me.minute, p.name, me.description, me.team_id "
-        "FROM match_events me "
-        "LEFT JOIN players p ON me.player_id = p.id "
-        "WHERE me.match_id = ? "
-        "ORDER BY me.minute"
-    );
-    scorersQuery.addBindValue(matchId);
-
-    scorersTable->setRowCount(0);
-    scorersTable->setColumnCount(5);
-    scorersTable->setHorizontalHeaderLabels({"Тип", "Минута", "Игрок", "Описание", "Команда"});
-
-    if (!scorersQuery.exec()) {
-        qDebug() << "Ошибка загрузки событий матча:" << scorersQuery.lastError().text();
+    TRACE_SCOPE("SportsTracker::runSearch");
+    QString text = searchEdit->text().trimmed();
+    if (text.size() < SearchMinLength) {
+        dataWorker->cancel(DataWorker::SearchChannel);
+        searchModel->clear();
         return;
     }
 
-    // Получаем фактические ID команд
-    int team1Id = -1, team2Id = -1;
-    QSqlQuery teamQuery(db);
+    searchTicket = dataWorker->requestSearch(text, SearchLimit);
+}
+
+void SportsTracker::onSearchResultsLoaded(quint64 ticket, const QString &text,
+                                          const QVector<SearchResult> &rows)
+{
+    TraceScope trace("SportsTracker::onSearchResultsLoaded");
+    Q_UNUSED(text);
+    if (ticket != searchTicket) return;
+    searchModel->setRows(rows);
+    trace.setRows(searchModel->rowCount());
+}
 
-    teamQuery.prepare("SELECT id FROM teams WHERE name = ?");
-    teamQuery.addBindValue(team1);
-    if (teamQuery.exec() && teamQuery.next()) {
-        team1Id = teamQuery.value(0).toInt();
-    }
+void SportsTracker::onSearchResultActivated(const QModelIndex &index)
+{
+    TRACE_SCOPE("SportsTracker::onSearchResultActivated");
+    if (!index.isValid()) return;
 
-    teamQuery.prepare("SELECT id FROM teams WHERE name = ?");
-    teamQuery.addBindValue(team2);
-    if (teamQuery.exec() && teamQuery.next()) {
-        team2Id = teamQuery.value(0).toInt();
-    }
+    const SearchResult &result = searchModel->resultAt(index.row());
+    if (result.tournamentId == -1) return;
 
-    while (scorersQuery.next()) {
-        int row = scorersTable->rowCount();
-        scorersTable->insertRow(row);
-
-        QString eventType = scorersQuery.value(0).toString();
-        if (eventType == "goal") eventType = "Гол";
-        else if (eventType == "yellow_card") eventType = "ЖК";
-        else if (eventType == "red_card") eventType = "КК";
-        else if (eventType == "substitution") eventType = "Замена";
-
-        int teamId = scorersQuery.value(4).toInt();
-        QString teamName = (teamId == team1Id) ? team1 : team2;
-        QString playerName = scorersQuery.value(2).isNull() ? "-" : scorersQuery.value(2).toString();
-
-        scorersTable->setItem(row, 0, new QTableWidgetItem(eventType));
-        scorersTable->setItem(row, 1, new QTableWidgetItem(scorersQuery.value(1).toString()));
-        scorersTable->setItem(row, 2, new QTableWidgetItem(playerName));
-        scorersTable->setItem(row, 3, new QTableWidgetItem(scorersQuery.value(3).toString()));
-        scorersTable->setItem(row, 4, new QTableWidgetItem(teamName));
-    }
-    scorersTable->resizeColumnsToContents();
+    pendingRound = result.kind == SearchResult::SearchMatch ? result.round : -1;
+    showTournamentPage(result.tournamentId, result.tournamentName);
 }
 
-void SportsTracker::loadRecentMatches(const QString& team, const QDate& beforeDate, QTableWidget* table)
+void SportsTracker::showDatabaseDiagnostics()
 {
-    QSqlQuery recentQuery(db);
-    recentQuery.prepare(
-        "SELECT m.date, t1.name, t2.name, m.score "
-        "FROM matches m "
-        "JOIN teams t1 ON m.team1_id = t1.id "
-        "JOIN teams t2 ON m.team2_id = t2.id "
-        "WHERE (t1.name = ? OR t2.name = ?) AND m.date < ? "
-        "ORDER BY m.date DESC LIMIT 5"
-    );
-    recentQuery.addBindValue(team);
-    recentQuery.addBindValue(team);
-    recentQuery.addBindValue(beforeDate.toString(Qt::ISODate));
-
-    if (recentQuery.exec()) {
-        table->setRowCount(0);
-        table->setColumnCount(4);
-        table->setHorizontalHeaderLabels({"Дата", "Команда 1", "Команда 2", "Счет"});
-
-        while (recentQuery.next()) {
-            int row = table->rowCount();
-            table->insertRow(row);
-
-            for (int col = 0; col < 4; ++col) {
-                table->setItem(row, col, new QTableWidgetItem(recentQuery.value(col).toString()));
-            }
-        }
-        table->resizeColumnsToContents();
-    } else {
-        qDebug() << "Ошибка загрузки последних матчей:" << recentQuery.lastError().text();
-    }
+    // Параметры показываются для соединения воркера, которое открывает БД на запись
+    dataWorker->requestDiagnostics();
 }
 
-void SportsTracker::loadHeadToHeadMatches(const QString& team1, const QString& team2, const QDate& beforeDate, QTableWidget* table)
+void SportsTracker::onDiagnosticsLoaded(quint64 ticket, const QStringList &lines)
 {
-    QSqlQuery h2hQuery(db);
-    h2hQuery.prepare(
-        "SELECT m.date, t1.name, t2.name, m.score "
-        "FROM matches m "
-        "JOIN teams t1 ON m.team1_id = t1.id "
-        "JOIN teams t2 ON m.team2_id = t2.id "
-        "WHERE ((t1.name = ? AND t2.name = ?) OR (t1.name = ? AND t2.name = ?)) AND m.date < ? "
-        "ORDER BY m.date DESC LIMIT 10"
-    );
-    h2hQuery.addBindValue(team1);
-    h2hQuery.addBindValue(team2);
-    h2hQuery.addBindValue(team2);
-    h2hQuery.addBindValue(team1);
-    h2hQuery.addBindValue(beforeDate.toString(Qt::ISODate));
-
-    if (h2hQuery.exec()) {
-        table->setRowCount(0);
-        table->setColumnCount(4);
-        table->setHorizontalHeaderLabels({"Дата", "Команда 1", "Команда 2", "Счет"});
-
-        while (h2hQuery.next()) {
-            int row = table->rowCount();
-            table->insertRow(row);
-
-            for (int col = 0; col < 4; ++col) {
-                table->setItem(row, col, new QTableWidgetItem(h2hQuery.value(col).toString()));
-            }
-        }
-        table->resizeColumnsToContents();
-    } else {
-        qDebug() << "Ошибка загрузки очных встреч:" << h2hQuery.lastError().text();
+    TraceScope trace("SportsTracker::onDiagnosticsLoaded");
+    Q_UNUSED(ticket);
+    trace.setRows(lines.size());
+    for (const QString &line : lines) {
+        qDebug().noquote() << line;
     }
+    QMessageBox::information(this, "Параметры БД", lines.join("\n"));
 }
 
 void SportsTracker::showMatchesList()
@@ -3,13 +3,33 @@
 
 #include <QMainWindow>
 #include <QTreeWidget>
-#include <QListWidget>
-#include <QTableWidget>
+#include <QListView>
+#include <QTableView>
 #include <QStackedWidget>
 #include <QPushButton>
-#include <QSqlDatabase>
 #include <QLabel>
+#include <QLineEdit>
+#include <QTimer>
+#include <QComboBox>
 #include <QTabWidget>
+#include <QThread>
+#include <QHash>
+
+#include "datatypes.h"
+#include "matchdetailscache.h"
+#include "databaseconfig.h"
+#include "navigationsnapshot.h"
+
+class DataWorker;
+class StandingsModel;
+class MatchListModel;
+class MatchEventsModel;
+class HistoryModel;
+class SearchResultsModel;
+class LeadersModel;
+class MatchStatsModel;
+class LineupsModel;
+class TeamStatsModel;
 
 class SportsTracker : public QMainWindow
 {
@@ -27,31 +47,81 @@ private slots:
     void loadMatchesForCurrentRound();
     void loadMatchesAndStandings();
     void loadStandings();
+    void onSportsLoaded(quint64 ticket, const QVector<SportRow> &rows);
+    void onTournamentsLoaded(quint64 ticket, int sportId, const QVector<TournamentRow> &rows);
+    void onRoundsLoaded(quint64 ticket, int tournamentId, const QVector<RoundInfo> &rounds);
+    void fetchMatchPage(const MatchPageCursor &after);
+    void onMatchPageLoaded(quint64 ticket, const QVector<MatchListRow> &rows, bool last);
+    void onStandingsLoaded(quint64 ticket, const QVector<StandingRow> &rows);
+    void onSeasonProjectionLoaded(quint64 ticket, int tournamentId, const QVector<SeasonProjection> &rows);
+    void onMatchStatsLoaded(quint64 ticket, const QVector<StatRow> &stats);
+    void onLineupsLoaded(quint64 ticket, const QVector<LineupEntry> &lineups);
+    void onEventsLoaded(quint64 ticket, const QVector<EventRow> &events);
+    void onRecentMatchesLoaded(quint64 ticket, int side, const QVector<HistoryRow> &rows);
+    void onHeadToHeadLoaded(quint64 ticket, const QVector<HistoryRow> &rows);
+    void onMatchDetailsPrefetched(quint64 ticket, const MatchDetails &details);
+    void saveTrace();
+    void showDatabaseDiagnostics();
+    void onDiagnosticsLoaded(quint64 ticket, const QStringList &lines);
+    void onDatabaseOpened(bool ok, const QString &error);
+    void runSearch();
+    void onSearchResultsLoaded(quint64 ticket, const QString &text, const QVector<SearchResult> &rows);
+    void onSearchResultActivated(const QModelIndex &index);
+    void loadLeaders();
+    void onDatabaseChanged();
+    void onLiveRefreshed(quint64 ticket, const LiveUpdate &update);
+    void onLeadersLoaded(quint64 ticket, int tournamentId, int category, const QVector<LeaderRow> &rows);
+    void loadTeamStats();
+    void onTeamStatsLoaded(quint64 ticket, const TeamStatsTable &table);
+    void onRoundPrefetched(quint64 ticket, int tournamentId, int round,
+                           const QVector<MatchListRow> &rows, bool complete);
 
 private:
     void setupUI();
-    bool initializeDatabase();
+    void initializeDatabase();
+    void restoreSnapshot();
+    void saveSnapshot();
+    void resizeStandingsColumns();
     void loadSports();
     void loadTournaments(QTreeWidgetItem *sportItem);
     void loadMatchesAndStandings(int tournamentId);
-    void showMatchStats(QListWidgetItem *item);
+    void showMatchStats(const QModelIndex &index);
     void showMatchesList();
-    void loadMatchStats(int matchId, const QString& team1, const QString& team2);
-    void loadLineups(int matchId, const QString& team1, const QString& team2);
-    void loadScorers(int matchId, const QString& team1, const QString& team2);
-    void loadRecentMatches(const QString& team, const QDate& beforeDate, QTableWidget* table);
-    void loadHeadToHeadMatches(const QString& team1, const QString& team2, const QDate& beforeDate, QTableWidget* table);
+    void fillLineups(const MatchHeader& header, const QVector<LineupEntry>& lineups);
+    void showMatchDetails(const MatchDetails &details);
+    void markDetailsPartLoaded(int part);
+    void prefetchNeighbourMatches(int row);
+    void prefetchAdjacentRounds();
+    void updateRoundButtons();
 
     QStackedWidget *stackedWidget;
     QTreeWidget *sportsTree;
-    QListWidget *matchesList;
-    QTableWidget *standingsTable;
-    QTableWidget *statsTable;
-    QTableWidget *lineupsTable;
-    QTableWidget *scorersTable;
-    QTableWidget *team1RecentMatches;
-    QTableWidget *team2RecentMatches;
-    QTableWidget *headToHeadMatches;
+    QListView *matchesList;
+    QTableView *standingsTable;
+    QTableView *statsTable;
+    QTableView *lineupsTable;
+    QTableView *scorersTable;
+    QTableView *team1RecentMatches;
+    QTableView *team2RecentMatches;
+    QTableView *headToHeadMatches;
+    QLineEdit *searchEdit;
+    QListView *searchResults;
+    QTableView *leadersTable;
+    QComboBox *leadersCategory;
+    QTableView *teamStatsTable;
+    QComboBox *teamStatsAggregate;
+    QTabWidget *tournamentTabs;     // турнирная таблица, лидеры и статистика команд
+    MatchListModel *matchesModel;
+    StandingsModel *standingsModel;
+    MatchEventsModel *scorersModel;
+    HistoryModel *team1RecentModel;
+    HistoryModel *team2RecentModel;
+    HistoryModel *headToHeadModel;
+    SearchResultsModel *searchModel;
+    LeadersModel *leadersModel;
+    MatchStatsModel *statsModel;
+    LineupsModel *lineupsModel;
+    TeamStatsModel *teamStatsModel;
     QLabel *matchTitle;
     QPushButton *backButton1;
     QPushButton *backButton2;
@@ -62,14 +132,42 @@ private:
     int currentTournamentId;
     QString currentTournamentName;
     int currentRound;
+    int pendingRound;       // тур найденного матча, который выбрать после загрузки туров
     int currentRoundPage;
     int roundsPerPage;
-    QList<int> allRounds;
+    QVector<RoundInfo> allRounds;
+    QHash<int, QVector<MatchListRow>> roundMatches;     // загруженные целиком туры текущего турнира
     QWidget *roundsPopup;
     QPushButton *roundButton;
     QButtonGroup *roundsGroup;
+    QVector<QPushButton *> roundPageButtons;            // кнопки страницы попапа, создаются один раз
+    QWidget *roundsNavigation;
+    QPushButton *prevRoundsButton;
+    QPushButton *nextRoundsButton;
     int currentMatchId;
-    QSqlDatabase db;
+    DatabaseConfig databaseConfig;      // параметры открытия, общие для всех соединений
+    QString snapshotPath;               // снимок навигации прошлого сеанса
+
+    QThread dataThread;
+    DataWorker *dataWorker;
+    quint64 roundsTicket;
+    quint64 matchesTicket;
+    quint64 standingsTicket;
+    quint64 projectionTicket;
+    quint64 matchDetailsTicket;
+    quint64 searchTicket;
+    quint64 leadersTicket;
+    quint64 teamStatsTicket;
+    quint64 liveTicket;
+    QTimer searchTimer;     // откладывает поиск до паузы в наборе
+    MatchHeader currentMatchHeader;
+
+    // Открытые ранее страницы матчей и страница, собираемая из пришедших панелей
+    MatchDetailsCache detailsCache;
+    MatchDetails pendingDetails;
+    int pendingParts;
+
+    QString tracePath;      // куда выгрузить трассировку при выходе (SPORTSTRACKER_TRACE)
 };
 
 #endif // SPORTSTRACKER_H
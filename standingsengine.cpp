@@ -0,0 +1,355 @@
+#include "standingsengine.h"
+#include "tracing.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <algorithm>
+
+StandingsEngine::StandingsEngine()
+    : currentTournamentId(-1),
+      sport(SportKind::Football),
+      fullRewrite(false)
+{
+}
+
+bool StandingsEngine::load(const QSqlDatabase &db, int tournamentId)
+{
+    TRACE_SCOPE_CATEGORY("StandingsEngine::load", "compute");
+    currentTournamentId = tournamentId;
+    teams.clear();
+    indexByTeam.clear();
+    dirtyTeams.clear();
+
+    // Вид спорта турнира определяет очки за исход и порядок мест
+    QSqlQuery sportQuery(db);
+    sportQuery.prepare(
+        "SELECT s.name FROM tournaments t JOIN sports s ON s.id = t.sport_id WHERE t.id = ?");
+    sportQuery.addBindValue(tournamentId);
+    if (!sportQuery.exec()) {
+        qDebug() << "Ошибка загрузки вида спорта турнира:" << sportQuery.lastError().text();
+        currentTournamentId = -1;
+        return false;
+    }
+    sport = sportQuery.next() ? sportKindFromName(sportQuery.value(0).toString()) : SportKind::Football;
+    sportQuery.finish();
+
+    QSqlQuery query(db);
+    query.prepare(
+        "SELECT m.team1_id, t1.name, m.team2_id, t2.name, m.home_goals, m.away_goals, m.match_status "
+        "FROM matches m "
+        "JOIN teams t1 ON m.team1_id = t1.id "
+        "JOIN teams t2 ON m.team2_id = t2.id "
+        "WHERE m.tournament_id = ?"
+    );
+    query.addBindValue(tournamentId);
+
+    if (!query.exec()) {
+        qDebug() << "Ошибка расчёта турнирной таблицы:" << query.lastError().text();
+        currentTournamentId = -1;
+        return false;
+    }
+
+    withSportRules(sport, [this, &query](auto rules) {
+        using Rules = decltype(rules);
+        while (query.next()) {
+            int team1Id = query.value(0).toInt();
+            int team2Id = query.value(2).toInt();
+            record(team1Id).name = query.value(1).toString();
+            record(team2Id).name = query.value(3).toString();
+
+            MatchResult result = MatchResult::fromColumns(query.value(4), query.value(5));
+            if (countsForStandings(result, query.value(6).toString())) {
+                addResult<Rules>(team1Id, team2Id, result, 1);
+            }
+        }
+        fullSort<Rules>();
+    });
+
+    fullRewrite = true;
+    return true;
+}
+
+StandingsEngine::TeamRecord &StandingsEngine::record(int teamId)
+{
+    auto it = indexByTeam.constFind(teamId);
+    if (it != indexByTeam.constEnd()) {
+        return teams[it.value()];
+    }
+
+    TeamRecord team;
+    team.teamId = teamId;
+    indexByTeam.insert(teamId, teams.size());
+    teams.append(team);
+    return teams.last();
+}
+
+template <typename Rules>
+void StandingsEngine::addResult(int team1Id, int team2Id, const MatchResult &result, int sign)
+{
+    const int goals1 = result.homeGoals;
+    const int goals2 = result.awayGoals;
+
+    // sign = 1 добавляет результат, sign = -1 отменяет ранее учтённый.
+    // Сначала создаём обе строки: record() может перераспределить teams
+    record(team1Id);
+    record(team2Id);
+    TeamRecord &home = teams[indexByTeam.value(team1Id)];
+    TeamRecord &away = teams[indexByTeam.value(team2Id)];
+
+    home.played += sign;
+    home.goalsFor += sign * goals1;
+    home.goalsAgainst += sign * goals2;
+    away.played += sign;
+    away.goalsFor += sign * goals2;
+    away.goalsAgainst += sign * goals1;
+
+    const int outcome = result.outcome();
+    if (outcome > 0) {
+        home.wins += sign;
+        home.points += sign * Rules::WinPoints;
+        away.losses += sign;
+        away.points += sign * Rules::LossPoints;
+    } else if (outcome < 0) {
+        away.wins += sign;
+        away.points += sign * Rules::WinPoints;
+        home.losses += sign;
+        home.points += sign * Rules::LossPoints;
+    } else if (Rules::HasDraws) {
+        home.draws += sign;
+        home.points += sign * Rules::DrawPoints;
+        away.draws += sign;
+        away.points += sign * Rules::DrawPoints;
+    } else {
+        // Ничьих в этом виде спорта не бывает: ошибочно записанный
+        // равный счёт считается поражением обеих команд
+        home.losses += sign;
+        home.points += sign * Rules::LossPoints;
+        away.losses += sign;
+        away.points += sign * Rules::LossPoints;
+    }
+
+    dirtyTeams.insert(team1Id);
+    dirtyTeams.insert(team2Id);
+}
+
+// При полном равенстве по правилам вида спорта команды идут по алфавиту
+template <typename Rules>
+bool StandingsEngine::ranksBefore(const TeamRecord &a, const TeamRecord &b)
+{
+    const int order = Rules::compare(a, b);
+    if (order != 0) return order < 0;
+    return a.name < b.name;
+}
+
+template <typename Rules>
+void StandingsEngine::fullSort()
+{
+    std::stable_sort(teams.begin(), teams.end(), ranksBefore<Rules>);
+    indexByTeam.clear();
+    for (int i = 0; i < teams.size(); ++i) {
+        indexByTeam.insert(teams[i].teamId, i);
+    }
+}
+
+template <typename Rules>
+void StandingsEngine::resort()
+{
+    // Результат меняет сразу две строки, и сдвиг каждой по отдельности
+    // может оставить между ними команду не на своём месте. Таблица турнира
+    // невелика, поэтому она пересортировывается целиком, а записываются
+    // только строки, сменившие место
+    QVector<int> previousOrder;
+    previousOrder.reserve(teams.size());
+    for (const TeamRecord &team : teams) {
+        previousOrder.append(team.teamId);
+    }
+
+    fullSort<Rules>();
+
+    for (int i = 0; i < teams.size(); ++i) {
+        if (teams[i].teamId != previousOrder[i]) {
+            dirtyTeams.insert(teams[i].teamId);
+        }
+    }
+}
+
+void StandingsEngine::applyResult(int team1Id, int team2Id, const MatchResult &oldResult, const MatchResult &newResult)
+{
+    withSportRules(sport, [&](auto rules) {
+        using Rules = decltype(rules);
+        if (oldResult.isValid()) {
+            addResult<Rules>(team1Id, team2Id, oldResult, -1);
+        }
+        if (newResult.isValid()) {
+            addResult<Rules>(team1Id, team2Id, newResult, 1);
+        }
+
+        resort<Rules>();
+    });
+}
+
+bool StandingsEngine::recordResult(QSqlDatabase db, int matchId, const MatchResult &result)
+{
+    TRACE_SCOPE_CATEGORY("StandingsEngine::recordResult", "compute");
+    if (!result.isValid()) {
+        qDebug() << "Некорректный счёт матча" << matchId;
+        return false;
+    }
+
+    QSqlQuery matchQuery(db);
+    matchQuery.prepare(
+        "SELECT team1_id, team2_id, home_goals, away_goals, match_status FROM matches "
+        "WHERE id = ? AND tournament_id = ?"
+    );
+    matchQuery.addBindValue(matchId);
+    matchQuery.addBindValue(currentTournamentId);
+
+    if (!matchQuery.exec() || !matchQuery.next()) {
+        qDebug() << "Матч" << matchId << "не найден в турнире" << currentTournamentId;
+        return false;
+    }
+
+    int team1Id = matchQuery.value(0).toInt();
+    int team2Id = matchQuery.value(1).toInt();
+    MatchResult oldResult = MatchResult::fromColumns(matchQuery.value(2), matchQuery.value(3));
+    if (!countsForStandings(oldResult, matchQuery.value(4).toString())) {
+        oldResult = MatchResult();
+    }
+    matchQuery.finish();
+
+    if (!db.transaction()) {
+        qDebug() << "Не удалось начать транзакцию:" << db.lastError().text();
+        return false;
+    }
+
+    // home_goals и away_goals обновляет триггер по новому тексту счёта
+    QSqlQuery updateQuery(db);
+    updateQuery.prepare("UPDATE matches SET score = ?, match_status = 'finished' WHERE id = ?");
+    updateQuery.addBindValue(result.toString());
+    updateQuery.addBindValue(matchId);
+
+    if (!updateQuery.exec()) {
+        qDebug() << "Ошибка записи результата матча:" << updateQuery.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    applyResult(team1Id, team2Id, oldResult, result);
+
+    // Счёт матча и затронутые строки таблицы фиксируются вместе
+    if (!writeRows(db) || !db.commit()) {
+        qDebug() << "Не удалось записать результат матча:" << db.lastError().text();
+        db.rollback();
+        // Состояние в памяти уже изменено: пересобираем таблицу из БД
+        load(db, currentTournamentId);
+        return false;
+    }
+
+    dirtyTeams.clear();
+    fullRewrite = false;
+    return true;
+}
+
+// В таблице учитываются только завершённые матчи; для старых записей без статуса
+// достаточно наличия счёта
+bool StandingsEngine::countsForStandings(const MatchResult &result, const QString &status)
+{
+    return (status.isEmpty() || status == "finished") && result.isValid();
+}
+
+bool StandingsEngine::save(QSqlDatabase db)
+{
+    if (!db.transaction()) {
+        qDebug() << "Не удалось начать транзакцию:" << db.lastError().text();
+        return false;
+    }
+
+    if (!writeChanges(db) || !db.commit()) {
+        qDebug() << "Не удалось зафиксировать турнирную таблицу:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    return true;
+}
+
+bool StandingsEngine::writeChanges(QSqlDatabase db)
+{
+    if (!writeRows(db)) {
+        return false;
+    }
+
+    dirtyTeams.clear();
+    fullRewrite = false;
+    return true;
+}
+
+bool StandingsEngine::writeRows(QSqlDatabase db)
+{
+    auto fail = [](const QSqlQuery &query) {
+        qDebug() << "Ошибка записи турнирной таблицы:" << query.lastError().text();
+        return false;
+    };
+
+    if (fullRewrite) {
+        QSqlQuery deleteQuery(db);
+        deleteQuery.prepare("DELETE FROM standings WHERE tournament_id = ?");
+        deleteQuery.addBindValue(currentTournamentId);
+        if (!deleteQuery.exec()) return fail(deleteQuery);
+    }
+
+    QSqlQuery upsertQuery(db);
+    upsertQuery.prepare(
+        "INSERT INTO standings (tournament_id, team_id, position, points, games_played, wins, draws, "
+        "losses, goals_for, goals_against, goal_difference) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) "
+        "ON CONFLICT(tournament_id, team_id) DO UPDATE SET "
+        "position = excluded.position, points = excluded.points, "
+        "games_played = excluded.games_played, wins = excluded.wins, draws = excluded.draws, "
+        "losses = excluded.losses, goals_for = excluded.goals_for, "
+        "goals_against = excluded.goals_against, goal_difference = excluded.goal_difference"
+    );
+
+    for (int i = 0; i < teams.size(); ++i) {
+        const TeamRecord &team = teams[i];
+        if (!fullRewrite && !dirtyTeams.contains(team.teamId)) continue;
+
+        upsertQuery.addBindValue(currentTournamentId);
+        upsertQuery.addBindValue(team.teamId);
+        upsertQuery.addBindValue(i + 1);
+        upsertQuery.addBindValue(team.points);
+        upsertQuery.addBindValue(team.played);
+        upsertQuery.addBindValue(team.wins);
+        upsertQuery.addBindValue(team.draws);
+        upsertQuery.addBindValue(team.losses);
+        upsertQuery.addBindValue(team.goalsFor);
+        upsertQuery.addBindValue(team.goalsAgainst);
+        upsertQuery.addBindValue(team.goalsFor - team.goalsAgainst);
+        if (!upsertQuery.exec()) return fail(upsertQuery);
+    }
+    return true;
+}
+
+QVector<StandingRow> StandingsEngine::rows() const
+{
+    QVector<StandingRow> result;
+    result.reserve(teams.size());
+
+    for (int i = 0; i < teams.size(); ++i) {
+        const TeamRecord &team = teams[i];
+        StandingRow row;
+        row.position = i + 1;
+        row.zone = standingZone(sport, row.position, teams.size());
+        row.teamId = team.teamId;
+        row.team = team.name;
+        row.points = team.points;
+        row.played = team.played;
+        row.wins = team.wins;
+        row.draws = team.draws;
+        row.losses = team.losses;
+        row.goalsFor = team.goalsFor;
+        row.goalsAgainst = team.goalsAgainst;
+        result.append(row);
+    }
+    return result;
+}
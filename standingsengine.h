@@ -0,0 +1,72 @@
+#ifndef STANDINGSENGINE_H
+#define STANDINGSENGINE_H
+
+#include "datatypes.h"
+#include "sportrules.h"
+
+#include <QSqlDatabase>
+#include <QHash>
+#include <QSet>
+
+// Турнирная таблица, вычисляемая по результатам матчей (matches.home_goals/away_goals).
+// Очки, порядок мест и зоны считаются по правилам вида спорта турнира (sportrules.h):
+// правила выбираются один раз на вызов, а подсчёт и сортировка специализированы под них.
+// После полной сборки load() отдельный результат применяется инкрементально:
+// меняются только две команды матча, после чего таблица (пара десятков строк)
+// заново устойчиво сортируется целиком, а изменёнными считаются эти две строки
+// и все сменившие место. save() записывает изменённые строки в standings
+// одной транзакцией.
+class StandingsEngine
+{
+public:
+    StandingsEngine();
+
+    int tournamentId() const { return currentTournamentId; }
+    SportKind sportKind() const { return sport; }
+
+    bool load(const QSqlDatabase &db, int tournamentId);
+    void applyResult(int team1Id, int team2Id, const MatchResult &oldResult, const MatchResult &newResult);
+    bool recordResult(QSqlDatabase db, int matchId, const MatchResult &result);
+    bool save(QSqlDatabase db);
+    // То же, что save(), но в транзакции, уже открытой вызывающим
+    bool writeChanges(QSqlDatabase db);
+
+    // Входит ли результат матча с таким статусом в турнирную таблицу
+    static bool countsForStandings(const MatchResult &result, const QString &status);
+
+    QVector<StandingRow> rows() const;
+
+private:
+    struct TeamRecord
+    {
+        int teamId = -1;
+        QString name;
+        int played = 0;
+        int wins = 0;
+        int draws = 0;
+        int losses = 0;
+        int goalsFor = 0;
+        int goalsAgainst = 0;
+        int points = 0;
+    };
+
+    template <typename Rules>
+    static bool ranksBefore(const TeamRecord &a, const TeamRecord &b);
+    TeamRecord &record(int teamId);
+    template <typename Rules>
+    void addResult(int team1Id, int team2Id, const MatchResult &result, int sign);
+    template <typename Rules>
+    void fullSort();
+    template <typename Rules>
+    void resort();
+    bool writeRows(QSqlDatabase db);
+
+    int currentTournamentId;
+    SportKind sport;
+    QVector<TeamRecord> teams;      // строки таблицы в порядке мест
+    QHash<int, int> indexByTeam;    // team_id -> индекс в teams
+    QSet<int> dirtyTeams;           // строки, которые нужно записать в standings
+    bool fullRewrite;
+};
+
+#endif // STANDINGSENGINE_H
@@ -0,0 +1,118 @@
+#include "standingsmodel.h"
+
+StandingsModel::StandingsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void StandingsModel::setRows(const QVector<StandingRow> &newRows)
+{
+    beginResetModel();
+    rows = newRows;
+    projections.clear();
+    endResetModel();
+}
+
+void StandingsModel::updateRows(const QVector<StandingRow> &newRows)
+{
+    if (newRows.size() != rows.size()) {
+        // Другой состав турнира показывается заново, но с уже посчитанным прогнозом
+        QHash<int, SeasonProjection> kept = projections;
+        setRows(newRows);
+        projections = kept;
+        return;
+    }
+
+    for (int i = 0; i < rows.size(); ++i) {
+        if (rows[i] == newRows[i]) continue;
+        rows[i] = newRows[i];
+        emit dataChanged(index(i, 0), index(i, ColumnCount - 1));
+    }
+}
+
+void StandingsModel::setProjections(const QVector<SeasonProjection> &newProjections)
+{
+    projections.clear();
+    for (const SeasonProjection &projection : newProjections) {
+        projections.insert(projection.teamId, projection);
+    }
+
+    if (!rows.isEmpty()) {
+        emit dataChanged(index(0, TitleChanceColumn), index(rows.size() - 1, RelegationChanceColumn));
+    }
+}
+
+void StandingsModel::clear()
+{
+    setRows(QVector<StandingRow>());
+}
+
+int StandingsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+int StandingsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant StandingsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+
+    const StandingRow &row = rows.at(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case PositionColumn: return row.position;
+        case TeamColumn: return row.team;
+        case PointsColumn: return row.points;
+        case PlayedColumn: return row.played;
+        case WinsColumn: return row.wins;
+        case DrawsColumn: return row.draws;
+        case LossesColumn: return row.losses;
+        case GoalsForColumn: return row.goalsFor;
+        case GoalsAgainstColumn: return row.goalsAgainst;
+        case GoalDifferenceColumn: return row.goalsFor - row.goalsAgainst;
+        case TitleChanceColumn:
+        case EuropeChanceColumn:
+        case RelegationChanceColumn: {
+            auto it = projections.constFind(row.teamId);
+            if (it == projections.constEnd()) return QVariant();
+            double chance = index.column() == TitleChanceColumn ? it->title
+                          : index.column() == EuropeChanceColumn ? it->europe
+                          : it->relegation;
+            return QString::number(chance * 100.0, 'f', 1);
+        }
+        }
+        break;
+    case Qt::ToolTipRole:
+        if (index.column() == TeamColumn) return row.team;
+        if (index.column() >= TitleChanceColumn && projections.contains(row.teamId)) {
+            return QString("Ожидаемые очки: %1")
+                .arg(projections.value(row.teamId).expectedPoints, 0, 'f', 1);
+        }
+        break;
+    case Qt::TextAlignmentRole:
+        return index.column() == TeamColumn
+            ? int(Qt::AlignLeft | Qt::AlignVCenter)
+            : int(Qt::AlignCenter);
+    case ZoneRole:
+        return row.zone;
+    }
+    return QVariant();
+}
+
+QVariant StandingsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    static const char *headers[ColumnCount] = {"Поз", "Команда", "О", "И", "В", "Н", "П", "ЗГ", "ПГ", "РГ",
+                                               "Чемп %", "Евр %", "Выл %"};
+    if (section < 0 || section >= ColumnCount) return QVariant();
+    return QString::fromUtf8(headers[section]);
+}
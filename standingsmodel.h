@@ -0,0 +1,58 @@
+#ifndef STANDINGSMODEL_H
+#define STANDINGSMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractTableModel>
+#include <QHash>
+
+// Турнирная таблица: хранит строки в компактном виде и отдаёт
+// текст, выравнивание и зону только по запросу представления.
+// Цвет зоны рисует StandingsDelegate.
+class StandingsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        PositionColumn,
+        TeamColumn,
+        PointsColumn,
+        PlayedColumn,
+        WinsColumn,
+        DrawsColumn,
+        LossesColumn,
+        GoalsForColumn,
+        GoalsAgainstColumn,
+        GoalDifferenceColumn,
+        TitleChanceColumn,
+        EuropeChanceColumn,
+        RelegationChanceColumn,
+        ColumnCount
+    };
+
+    enum Role {
+        ZoneRole = Qt::UserRole + 1     // StandingZone строки
+    };
+
+    explicit StandingsModel(QObject *parent = nullptr);
+
+    void setRows(const QVector<StandingRow> &rows);
+    // Обновляет только изменившиеся строки; прогноз по командам сохраняется
+    void updateRows(const QVector<StandingRow> &rows);
+    // Вероятности по моделированию сезона; до их прихода столбцы пусты
+    void setProjections(const QVector<SeasonProjection> &projections);
+    void clear();
+    const QVector<StandingRow> &standings() const { return rows; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QVector<StandingRow> rows;
+    QHash<int, SeasonProjection> projections;   // team_id -> прогноз
+};
+
+#endif // STANDINGSMODEL_H
@@ -0,0 +1,43 @@
+#include "statcatalogue.h"
+#include <QHash>
+
+StatCatalogue::Entry StatCatalogue::entry(const QString &statName)
+{
+    static const QHash<QString, Entry> entries = []() {
+        QHash<QString, Entry> known;
+        const char *counts[] = {
+            "Удары", "Удары в створ", "Угловые", "Фолы", "Офсайды", "Сэйвы вратаря",
+            "Желтые карточки", "Жёлтые карточки", "Красные карточки"
+        };
+        for (const char *name : counts) {
+            Entry count;
+            count.type = Count;
+            known.insert(QString::fromUtf8(name), count);
+        }
+
+        Entry percent;
+        percent.type = Percent;
+        percent.unit = "%";
+        known.insert(QString::fromUtf8("Владение мячом"), percent);
+        return known;
+    }();
+
+    return entries.value(statName);
+}
+
+bool StatCatalogue::parse(const QString &text, double *value)
+{
+    QString number = text.trimmed();
+    if (number.endsWith('%')) number.chop(1);
+    number.replace(',', '.');
+
+    bool ok = false;
+    *value = number.toDouble(&ok);
+    return ok;
+}
+
+QString StatCatalogue::format(double value, ValueType type, int decimals)
+{
+    QString text = QString::number(value, 'f', decimals);
+    return type == Percent ? text + "%" : text;
+}
@@ -0,0 +1,32 @@
+#ifndef STATCATALOGUE_H
+#define STATCATALOGUE_H
+
+#include <QString>
+
+// Справочник показателей match_stats. Значения хранятся текстом ("55%", "7"),
+// а справочник сопоставляет названию показателя числовой тип и единицу,
+// чтобы значения можно было складывать и усреднять.
+class StatCatalogue
+{
+public:
+    enum ValueType {
+        Count,          // целое число за матч: удары, угловые, карточки
+        Percent,        // доля от 0 до 100: владение мячом
+        Decimal         // прочие числовые показатели
+    };
+
+    struct Entry
+    {
+        ValueType type = Decimal;
+        QString unit;
+    };
+
+    // Неизвестный показатель считается дробным числом без единицы
+    static Entry entry(const QString &statName);
+
+    // Разбор текста значения; false, если это не число
+    static bool parse(const QString &text, double *value);
+    static QString format(double value, ValueType type, int decimals);
+};
+
+#endif // STATCATALOGUE_H
@@ -0,0 +1,104 @@
+#include "statementcache.h"
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+StatementCache::StatementCache(const QSqlDatabase &db)
+    : db(db)
+{
+}
+
+StatementCache::~StatementCache()
+{
+    clear();
+}
+
+void StatementCache::clear()
+{
+    qDeleteAll(entries);
+    entries.clear();
+}
+
+StatementCache::Entry *StatementCache::entry(const QString &sql)
+{
+    auto it = entries.constFind(sql);
+    if (it != entries.constEnd()) {
+        return it.value();
+    }
+
+    Entry *newEntry = new Entry(db);
+    newEntry->stats.sql = sql;
+    // Имя события трассировки — начало текста запроса
+    newEntry->traceName = Trace::intern(sql.simplified().left(80));
+    newEntry->query.setForwardOnly(true);
+    newEntry->prepared = newEntry->query.prepare(sql);
+    if (!newEntry->prepared) {
+        qDebug() << "Ошибка подготовки запроса:" << newEntry->query.lastError().text() << sql;
+    }
+
+    entries.insert(sql, newEntry);
+    return newEntry;
+}
+
+QVector<StatementCache::Stats> StatementCache::stats() const
+{
+    QVector<Stats> result;
+    result.reserve(entries.size());
+    for (const Entry *statement : entries) {
+        result.append(statement->stats);
+    }
+    return result;
+}
+
+StatementCache::Run::Run(StatementCache &cache, const QString &sql)
+    : traceStart(-1),
+      rows(0)
+{
+    Entry *statement = cache.entry(sql);
+    query = &statement->query;
+    stats = &statement->stats;
+    traceName = statement->traceName;
+    prepared = statement->prepared;
+}
+
+StatementCache::Run::~Run()
+{
+    if (!timer.isValid()) return;
+
+    // Сбрасываем оператор SQLite, чтобы он не удерживал блокировку чтения
+    query->finish();
+
+    qint64 elapsed = timer.nsecsElapsed();
+    stats->executions++;
+    stats->rows += rows;
+    stats->totalNs += elapsed;
+    stats->maxNs = qMax(stats->maxNs, elapsed);
+
+    if (traceStart >= 0) {
+        Trace::record(traceName, "sql", traceStart, elapsed, qint64(rows));
+    }
+}
+
+StatementCache::Run &StatementCache::Run::bind(int position, const QVariant &value)
+{
+    query->bindValue(position, value);
+    return *this;
+}
+
+bool StatementCache::Run::exec()
+{
+    if (!prepared) return false;
+
+    if (Trace::enabled()) {
+        traceStart = Trace::now();
+    }
+    timer.start();
+    return query->exec();
+}
+
+bool StatementCache::Run::next()
+{
+    if (!query->next()) return false;
+    rows++;
+    return true;
+}
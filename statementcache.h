@@ -0,0 +1,79 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "tracing.h"
+
+// Реестр подготовленных запросов одного соединения. Каждый текст запроса
+// готовится (prepare) один раз, при повторном использовании заново
+// привязываются только параметры. Для каждого запроса накапливаются
+// число выполнений, число строк и время от exec() до конца чтения.
+class StatementCache
+{
+public:
+    struct Stats
+    {
+        QString sql;
+        quint64 executions = 0;
+        quint64 rows = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+    };
+
+    // Одно выполнение запроса из кэша. Параметры привязываются по позиции
+    // через bind(); деструктор сбрасывает запрос (finish) и записывает время.
+    class Run
+    {
+    public:
+        Run(StatementCache &cache, const QString &sql);
+        ~Run();
+
+        Run &bind(int position, const QVariant &value);
+        bool exec();
+        bool next();
+        QVariant value(int index) const { return query->value(index); }
+        QSqlError lastError() const { return query->lastError(); }
+        QSqlQuery &sqlQuery() { return *query; }
+
+    private:
+        Q_DISABLE_COPY(Run)
+
+        QSqlQuery *query;
+        Stats *stats;
+        const char *traceName;
+        qint64 traceStart;
+        QElapsedTimer timer;
+        quint64 rows;
+        bool prepared;
+    };
+
+    explicit StatementCache(const QSqlDatabase &db);
+    ~StatementCache();
+
+    QVector<Stats> stats() const;
+    void clear();
+
+private:
+    struct Entry
+    {
+        QSqlQuery query;
+        Stats stats;
+        const char *traceName = nullptr;
+        bool prepared = false;
+
+        explicit Entry(const QSqlDatabase &db) : query(db) {}
+    };
+
+    Entry *entry(const QString &sql);
+
+    QSqlDatabase db;
+    QHash<QString, Entry *> entries;
+};
+
+#endif // STATEMENTCACHE_H
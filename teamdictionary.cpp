@@ -0,0 +1,52 @@
+#include "teamdictionary.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+bool TeamDictionary::load(const QSqlDatabase &db)
+{
+    teams.clear();
+    teamIds.clear();
+    players.clear();
+    strings.clear();
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if (!query.exec("SELECT id, name FROM teams")) {
+        qDebug() << "Ошибка загрузки справочника команд:" << query.lastError().text();
+        return false;
+    }
+
+    while (query.next()) {
+        int id = query.value(0).toInt();
+        QString name = intern(query.value(1).toString());
+        teams.insert(id, name);
+        teamIds.insert(name, id);
+    }
+
+    if (!query.exec("SELECT id, name FROM players")) {
+        qDebug() << "Ошибка загрузки справочника игроков:" << query.lastError().text();
+        return false;
+    }
+
+    while (query.next()) {
+        players.insert(query.value(0).toInt(), intern(query.value(1).toString()));
+    }
+
+    // Пул нужен только на время загрузки: строки уже разделены словарями
+    strings.clear();
+    strings.squeeze();
+    return true;
+}
+
+QString TeamDictionary::intern(const QString &value)
+{
+    auto it = strings.constFind(value);
+    if (it != strings.constEnd()) {
+        return *it;
+    }
+    strings.insert(value);
+    return value;
+}
@@ -0,0 +1,34 @@
+#ifndef TEAMDICTIONARY_H
+#define TEAMDICTIONARY_H
+
+#include <QSqlDatabase>
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+// Справочник команд и игроков, загружаемый один раз при открытии БД.
+// Имена интернированы: одинаковые строки разделяют один буфер QString,
+// и все строки результатов, собранные из справочника, ссылаются на него же.
+// После загрузки объект не изменяется и может читаться из любых потоков.
+class TeamDictionary
+{
+public:
+    bool load(const QSqlDatabase &db);
+
+    QString teamName(int teamId) const { return teams.value(teamId); }
+    int teamId(const QString &name) const { return teamIds.value(name, -1); }
+    QString playerName(int playerId) const { return players.value(playerId); }
+
+    int teamCount() const { return teams.size(); }
+    int playerCount() const { return players.size(); }
+
+private:
+    QString intern(const QString &value);
+
+    QHash<int, QString> teams;
+    QHash<QString, int> teamIds;
+    QHash<int, QString> players;
+    QSet<QString> strings;
+};
+
+#endif // TEAMDICTIONARY_H
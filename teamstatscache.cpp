@@ -0,0 +1,107 @@
+#include "teamstatscache.h"
+#include "teamdictionary.h"
+#include "statcatalogue.h"
+#include "tracing.h"
+#include <algorithm>
+#include <numeric>
+
+// Четыре независимых накопителя, чтобы сложения не ждали друг друга
+// и цикл векторизовался без -ffast-math
+double TeamStatsCache::sum(const double *values, int count)
+{
+    double partial[4] = {0.0, 0.0, 0.0, 0.0};
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        partial[0] += values[i];
+        partial[1] += values[i + 1];
+        partial[2] += values[i + 2];
+        partial[3] += values[i + 3];
+    }
+    for (; i < count; ++i) {
+        partial[0] += values[i];
+    }
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+double TeamStatsCache::median(QVector<double> values)
+{
+    if (values.isEmpty()) return 0.0;
+    const int middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double result = values[middle];
+    if (values.size() % 2 == 0) {
+        result = (result + *std::max_element(values.begin(), values.begin() + middle)) / 2.0;
+    }
+    return result;
+}
+
+void TeamStatsCache::build(int tournamentId, qint64 dataVersion, const QVector<TeamStatSamples> &samples,
+                           const TeamDictionary &names)
+{
+    TRACE_SCOPE_CATEGORY("TeamStatsCache::build", "compute");
+    version = dataVersion;
+    data = TeamStatsTable();
+    data.tournamentId = tournamentId;
+
+    // Команды — все, у кого есть хоть один показатель, в порядке id
+    for (const TeamStatSamples &stat : samples) {
+        data.teamIds += stat.teamIds;
+    }
+    std::sort(data.teamIds.begin(), data.teamIds.end());
+    data.teamIds.erase(std::unique(data.teamIds.begin(), data.teamIds.end()), data.teamIds.end());
+    for (int teamId : data.teamIds) {
+        data.teams.append(names.teamName(teamId));
+    }
+
+    const int teamCount = data.teamIds.size();
+    const int cells = samples.size() * teamCount;
+    data.matches.fill(0, cells);
+    data.sums.fill(0.0, cells);
+    data.means.fill(0.0, cells);
+    data.percentiles.fill(0.0, cells);
+
+    for (int s = 0; s < samples.size(); ++s) {
+        const TeamStatSamples &stat = samples[s];
+        data.stats.append(stat.stat);
+        data.statTypes.append(StatCatalogue::entry(stat.stat).type);
+
+        // Значения команды идут подряд: суммируем каждый отрезок целиком
+        const double *values = stat.values.constData();
+        int team = 0;
+        for (int begin = 0; begin < stat.values.size();) {
+            int end = begin;
+            while (end < stat.values.size() && stat.teamIds[end] == stat.teamIds[begin]) ++end;
+            while (data.teamIds[team] != stat.teamIds[begin]) ++team;
+
+            const int cell = data.cell(s, team);
+            data.matches[cell] = end - begin;
+            data.sums[cell] = sum(values + begin, end - begin);
+            data.means[cell] = data.sums[cell] / (end - begin);
+            begin = end;
+        }
+
+        // Процентиль: доля команд с меньшим средним, равные делят место пополам
+        QVector<double> teamMeans;
+        for (int t = 0; t < teamCount; ++t) {
+            if (data.matches[data.cell(s, t)] > 0) teamMeans.append(data.means[data.cell(s, t)]);
+        }
+        std::sort(teamMeans.begin(), teamMeans.end());
+        for (int t = 0; t < teamCount; ++t) {
+            const int cell = data.cell(s, t);
+            if (data.matches[cell] == 0) continue;
+            if (teamMeans.size() == 1) {
+                data.percentiles[cell] = 100.0;
+                continue;
+            }
+            auto range = std::equal_range(teamMeans.begin(), teamMeans.end(), data.means[cell]);
+            const double below = range.first - teamMeans.begin();
+            const double equal = range.second - range.first;
+            data.percentiles[cell] = 100.0 * (below + (equal - 1) / 2.0) / (teamMeans.size() - 1);
+        }
+
+        const double total = sum(values, stat.values.size());
+        data.tournamentSums.append(total);
+        data.tournamentMeans.append(stat.values.isEmpty() ? 0.0 : total / stat.values.size());
+        data.tournamentMedians.append(median(stat.values));
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef TEAMSTATSCACHE_H
+#define TEAMSTATSCACHE_H
+
+#include "datatypes.h"
+
+class TeamDictionary;
+
+// Сезонные показатели команд последнего запрошенного турнира: сумма, среднее
+// за матч и процентиль среднего среди команд турнира по каждому показателю
+// match_stats, а также итоги турнира. Значения хранятся по столбцам
+// (TeamStatsTable), а считаются простыми циклами по непрерывным отрезкам,
+// которые компилятор векторизует. Пересчитываются, только если открыт другой
+// турнир или изменилась БД.
+class TeamStatsCache
+{
+public:
+    void build(int tournamentId, qint64 dataVersion, const QVector<TeamStatSamples> &samples,
+               const TeamDictionary &names);
+
+    int tournamentId() const { return data.tournamentId; }
+    qint64 dataVersion() const { return version; }
+    const TeamStatsTable &table() const { return data; }
+
+private:
+    static double sum(const double *values, int count);
+    static double median(QVector<double> values);
+
+    TeamStatsTable data;
+    qint64 version = -1;
+};
+
+#endif // TEAMSTATSCACHE_H
@@ -0,0 +1,142 @@
+#include "teamstatsmodel.h"
+#include "statcatalogue.h"
+#include <algorithm>
+
+TeamStatsModel::TeamStatsModel(QObject *parent)
+    : QAbstractTableModel(parent),
+      aggregate(Mean),
+      sortColumn(0),
+      sortOrder(Qt::AscendingOrder)
+{
+}
+
+void TeamStatsModel::setTable(const TeamStatsTable &newTable)
+{
+    beginResetModel();
+    table = newTable;
+    rows.resize(table.teamIds.size());
+    for (int i = 0; i < rows.size(); ++i) {
+        rows[i] = i;
+    }
+    applySort();
+    endResetModel();
+}
+
+void TeamStatsModel::setAggregate(Aggregate newAggregate)
+{
+    if (aggregate == newAggregate) return;
+    beginResetModel();
+    aggregate = newAggregate;
+    applySort();
+    endResetModel();
+}
+
+void TeamStatsModel::clear()
+{
+    setTable(TeamStatsTable());
+}
+
+int TeamStatsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+int TeamStatsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 1 + table.stats.size();
+}
+
+double TeamStatsModel::value(int stat, int team) const
+{
+    const int cell = table.cell(stat, team);
+    // Сумма долей не имеет смысла, для процентных показателей показываем среднее
+    if (aggregate == Sum && table.statTypes[stat] != StatCatalogue::Percent) return table.sums[cell];
+    if (aggregate == Percentile) return table.percentiles[cell];
+    return table.means[cell];
+}
+
+QVariant TeamStatsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+
+    if (role == Qt::TextAlignmentRole) {
+        return index.column() == 0 ? QVariant() : QVariant(Qt::AlignCenter);
+    }
+    if (role != Qt::DisplayRole) return QVariant();
+
+    const int team = rows.at(index.row());
+    if (index.column() == 0) return table.teams.at(team);
+
+    const int stat = index.column() - 1;
+    if (table.matches[table.cell(stat, team)] == 0) return "—";
+
+    const auto type = StatCatalogue::ValueType(table.statTypes[stat]);
+    switch (aggregate) {
+    case Sum:
+        return StatCatalogue::format(value(stat, team), type,
+                                     type == StatCatalogue::Count ? 0 : 1);
+    case Mean:
+        return StatCatalogue::format(value(stat, team), type, 1);
+    case Percentile:
+        return StatCatalogue::format(value(stat, team), StatCatalogue::Count, 0);
+    }
+    return QVariant();
+}
+
+QVariant TeamStatsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || section < 0 || section > table.stats.size()) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    if (role == Qt::DisplayRole) {
+        return section == 0 ? QString("Команда") : table.stats.at(section - 1);
+    }
+    if (role == Qt::ToolTipRole && section > 0) {
+        const int stat = section - 1;
+        const auto type = StatCatalogue::ValueType(table.statTypes[stat]);
+        QString tip = QString("Среднее за матч по турниру: %1\nМедиана: %2")
+            .arg(StatCatalogue::format(table.tournamentMeans[stat], type, 1),
+                 StatCatalogue::format(table.tournamentMedians[stat], type, 1));
+        if (type != StatCatalogue::Percent) {
+            tip.prepend(QString("Всего в турнире: %1\n")
+                .arg(StatCatalogue::format(table.tournamentSums[stat], type,
+                                           type == StatCatalogue::Count ? 0 : 1)));
+        }
+        return tip;
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+void TeamStatsModel::sort(int column, Qt::SortOrder order)
+{
+    emit layoutAboutToBeChanged();
+    sortColumn = column;
+    sortOrder = order;
+    applySort();
+    emit layoutChanged();
+}
+
+void TeamStatsModel::applySort()
+{
+    if (sortColumn < 0 || sortColumn > table.stats.size()) return;
+
+    const bool ascending = sortOrder == Qt::AscendingOrder;
+    if (sortColumn == 0) {
+        std::stable_sort(rows.begin(), rows.end(), [&](int a, int b) {
+            int result = QString::localeAwareCompare(table.teams.at(a), table.teams.at(b));
+            return ascending ? result < 0 : result > 0;
+        });
+        return;
+    }
+
+    // Команды без значения показателя всегда внизу
+    const int stat = sortColumn - 1;
+    std::stable_sort(rows.begin(), rows.end(), [&](int a, int b) {
+        const bool hasA = table.matches[table.cell(stat, a)] > 0;
+        const bool hasB = table.matches[table.cell(stat, b)] > 0;
+        if (hasA != hasB) return hasA;
+        if (!hasA) return false;
+        return ascending ? value(stat, a) < value(stat, b) : value(stat, a) > value(stat, b);
+    });
+}
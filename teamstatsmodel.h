@@ -0,0 +1,47 @@
+#ifndef TEAMSTATSMODEL_H
+#define TEAMSTATSMODEL_H
+
+#include "datatypes.h"
+
+#include <QAbstractTableModel>
+
+// Сезонные показатели команд турнира: команда и по столбцу на показатель.
+// Значения уже посчитаны TeamStatsCache, модель только выбирает агрегат
+// и порядок строк.
+class TeamStatsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Aggregate {
+        Sum,
+        Mean,           // за матч
+        Percentile      // место среднего за матч среди команд турнира
+    };
+
+    explicit TeamStatsModel(QObject *parent = nullptr);
+
+    void setTable(const TeamStatsTable &table);
+    void setAggregate(Aggregate aggregate);
+    void clear();
+
+    int tournamentId() const { return table.tournamentId; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    double value(int stat, int team) const;
+    void applySort();
+
+    TeamStatsTable table;
+    Aggregate aggregate;
+    QVector<int> rows;      // номера команд в table в порядке показа
+    int sortColumn;
+    Qt::SortOrder sortOrder;
+};
+
+#endif // TEAMSTATSMODEL_H
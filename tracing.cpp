@@ -0,0 +1,137 @@
+#include "tracing.h"
+#include <QSaveFile>
+#include <QSet>
+#include <QMutex>
+#include <QThread>
+#include <QDebug>
+#include <chrono>
+
+namespace {
+
+struct TraceEvent
+{
+    // 0 — слот пуст или пишется; иначе номер записи + 1
+    std::atomic<quint64> sequence{0};
+    const char *name = nullptr;
+    const char *category = nullptr;
+    qint64 startNs = 0;
+    qint64 durationNs = 0;
+    qint64 rows = -1;
+    quintptr threadId = 0;
+};
+
+TraceEvent events[Trace::Capacity];
+std::atomic<quint64> nextEvent{0};
+
+QMutex internMutex;
+
+QString jsonString(const char *value)
+{
+    QString text = QString::fromUtf8(value);
+    text.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', ' ').replace('\t', ' ');
+    return '"' + text + '"';
+}
+
+} // namespace
+
+void Trace::setEnabled(bool enabled)
+{
+    active.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 Trace::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::record(const char *name, const char *category, qint64 startNs, qint64 durationNs, qint64 rows)
+{
+    // Каждый поток занимает свой слот; при переполнении перезаписываются самые старые
+    const quint64 index = nextEvent.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent &event = events[index % Capacity];
+
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name = name;
+    event.category = category;
+    event.startNs = startNs;
+    event.durationNs = durationNs;
+    event.rows = rows;
+    event.threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+    event.sequence.store(index + 1, std::memory_order_release);
+}
+
+const char *Trace::intern(const QString &name)
+{
+    // Имена запросов интернируются один раз при подготовке и не освобождаются
+    static QSet<QByteArray> names;
+    QMutexLocker locker(&internMutex);
+    QByteArray utf8 = name.toUtf8();
+    auto it = names.constFind(utf8);
+    if (it == names.constEnd()) {
+        it = names.insert(utf8);
+    }
+    return it->constData();
+}
+
+void Trace::clear()
+{
+    for (TraceEvent &event : events) {
+        event.sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool Trace::dumpChromeTrace(const QString &path)
+{
+    QString json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+
+    for (const TraceEvent &slot : events) {
+        const quint64 before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0) continue;
+
+        TraceEvent copy;
+        copy.name = slot.name;
+        copy.category = slot.category;
+        copy.startNs = slot.startNs;
+        copy.durationNs = slot.durationNs;
+        copy.rows = slot.rows;
+        copy.threadId = slot.threadId;
+
+        // Слот перезаписан во время чтения: пропускаем его
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) continue;
+
+        if (!first) json += ",\n";
+        first = false;
+
+        json += QString("{\"name\":%1,\"cat\":%2,\"ph\":\"X\",\"pid\":1,\"tid\":%3,"
+                        "\"ts\":%4,\"dur\":%5")
+                    .arg(jsonString(copy.name), jsonString(copy.category))
+                    .arg(quint64(copy.threadId))
+                    .arg(copy.startNs / 1000.0, 0, 'f', 3)
+                    .arg(copy.durationNs / 1000.0, 0, 'f', 3);
+        if (copy.rows >= 0) {
+            json += QString(",\"args\":{\"rows\":%1}").arg(copy.rows);
+        }
+        json += '}';
+    }
+    json += "\n]}\n";
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(json.toUtf8()) < 0 || !file.commit()) {
+        qDebug() << "Не удалось сохранить трассировку" << path << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QString Trace::pathFromEnvironment()
+{
+    QString path = qEnvironmentVariable("SPORTSTRACKER_TRACE");
+    if (!path.isEmpty()) {
+        setEnabled(true);
+    }
+    return path;
+}
@@ -0,0 +1,67 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <QString>
+#include <atomic>
+
+// Трассировка запросов, заполнения виджетов и слотов интерфейса.
+// События пишутся в кольцевой буфер фиксированного размера без блокировок
+// и выгружаются в формате Chrome Trace (chrome://tracing, ui.perfetto.dev).
+// Пока трассировка выключена, TRACE_SCOPE стоит одну атомарную загрузку.
+class Trace
+{
+public:
+    static const int Capacity = 1 << 16;
+
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled);
+
+    static qint64 now();
+
+    // name и category должны жить до выгрузки буфера: строковые литералы или intern()
+    static void record(const char *name, const char *category, qint64 startNs, qint64 durationNs,
+                       qint64 rows = -1);
+    static const char *intern(const QString &name);
+
+    static bool dumpChromeTrace(const QString &path);
+    static void clear();
+
+    // Включает трассировку, если задана переменная SPORTSTRACKER_TRACE,
+    // и возвращает путь, куда выгрузить буфер при завершении
+    static QString pathFromEnvironment();
+
+private:
+    static inline std::atomic<bool> active{false};
+};
+
+// Замер области видимости; количество строк можно указать до выхода из неё
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name, const char *category = "ui")
+        : name(name), category(category), start(Trace::enabled() ? Trace::now() : -1), rows(-1) {}
+
+    ~TraceScope()
+    {
+        if (start >= 0) {
+            Trace::record(name, category, start, Trace::now() - start, rows);
+        }
+    }
+
+    void setRows(qint64 count) { rows = count; }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+
+    const char *name;
+    const char *category;
+    qint64 start;
+    qint64 rows;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_SCOPE_CATEGORY(name, category) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, category)
+
+#endif // TRACING_H